@@ -0,0 +1,118 @@
+#include <avr/eeprom.h>
+#include "Alarm.h"
+
+Alarm EEMEM alarmStore[ALARM_COUNT];
+
+//Every enabled alarm day as a minute of week, ascending
+static uint16_t alarmTimes[ALARM_COUNT * ALARM_DAYS_PER_WEEK];
+static uint8_t alarmTimesCount = 0;
+
+static uint16_t alarmNext = ALARM_NONE;
+
+//Minute of week of the last check or sync
+static uint16_t alarmLast = 0;
+
+static void build_alarm_times(void)
+{
+    Alarm alarm;
+    
+    alarmTimesCount = 0;
+    
+    for(uint8_t i = 0; i < ALARM_COUNT; ++i)
+    {
+        alarm_get(i, &alarm);
+        
+        //Erased EEPROM reads 0xFF
+        if(alarm.hour > 23 || alarm.minute > 59)
+            continue;
+        
+        uint16_t time = (alarm.hour * 60) + alarm.minute;
+        
+        for(uint8_t day = 0; day < ALARM_DAYS_PER_WEEK; ++day)
+        {
+            if(alarm.days & (1 << day))
+            {
+                //Insertion sort, table is small and only built on edit
+                uint8_t j = alarmTimesCount;
+                
+                while(j > 0 && alarmTimes[j - 1] > time)
+                    --j;
+                
+                //Alarms sharing a minute fire once
+                if(j == 0 || alarmTimes[j - 1] != time)
+                {
+                    for(uint8_t k = alarmTimesCount++; k > j; --k)
+                        alarmTimes[k] = alarmTimes[k - 1];
+                    
+                    alarmTimes[j] = time;
+                }
+            }
+            
+            time += ALARM_MINUTES_PER_DAY;
+        }
+    }
+    
+    alarmNext = ALARM_NONE;
+}
+
+void init_alarms(void)
+{
+    build_alarm_times();
+}
+
+void alarm_get(uint8_t index, Alarm* alarm)
+{
+    eeprom_read_block(alarm, &alarmStore[index], sizeof(Alarm));
+}
+
+void alarm_set(uint8_t index, const Alarm* alarm)
+{
+    eeprom_update_block(alarm, &alarmStore[index], sizeof(Alarm));
+    build_alarm_times();
+}
+
+//Minutes forward from after to minuteOfWeek, a full week when equal
+static uint16_t minutes_until(uint16_t after, uint16_t minuteOfWeek)
+{
+    return (minuteOfWeek > after) ? minuteOfWeek - after : minuteOfWeek + ALARM_MINUTES_PER_WEEK - after;
+}
+
+void alarm_sync(uint16_t minuteOfWeek)
+{
+    alarmLast = minuteOfWeek;
+    alarmNext = ALARM_NONE;
+    
+    if(alarmTimesCount == 0)
+        return;
+    
+    //First alarm after now, otherwise wrap to next week
+    alarmNext = alarmTimes[0];
+    
+    for(uint8_t i = 0; i < alarmTimesCount; ++i)
+    {
+        if(alarmTimes[i] > minuteOfWeek)
+        {
+            alarmNext = alarmTimes[i];
+            break;
+        }
+    }
+}
+
+uint8_t alarm_check(uint16_t minuteOfWeek)
+{
+    if(alarmNext == ALARM_NONE || minuteOfWeek == alarmLast)
+        return 0;
+    
+    //Due when the next alarm lies between the last check and now,
+    //a missed rollover or a skipped minute still catches it
+    if(minutes_until(alarmLast, alarmNext) > minutes_until(alarmLast, minuteOfWeek))
+    {
+        alarmLast = minuteOfWeek;
+        return 0;
+    }
+    
+    //Steps past every alarm up to now, several may have been passed
+    alarm_sync(minuteOfWeek);
+    
+    return 1;
+}
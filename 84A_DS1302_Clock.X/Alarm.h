@@ -0,0 +1,52 @@
+/*
+ * File:   Alarm.h
+ * Author: TallDwarf
+ *
+ * Weekly alarms stored in EEPROM
+ * Alarms are expanded into a sorted minute of week table when edited
+ * so the per minute check is a single compare against the next alarm
+ */
+
+#ifndef ALARM_H
+#define	ALARM_H
+
+#include <avr/io.h>
+
+#ifndef ALARM_COUNT
+#define ALARM_COUNT 4
+#endif
+
+#define ALARM_MINUTES_PER_DAY 1440
+#define ALARM_DAYS_PER_WEEK 7
+#define ALARM_MINUTES_PER_WEEK ((uint16_t)ALARM_MINUTES_PER_DAY * ALARM_DAYS_PER_WEEK)
+
+//Never matches a minute of week
+#define ALARM_NONE 0xFFFF
+
+typedef struct
+{
+    //Bit 0 = DS1302 day 1 ... bit 6 = day 7, 0 = disabled
+    uint8_t days;
+    uint8_t hour;
+    uint8_t minute;
+} Alarm;
+
+//Load alarms from EEPROM and build the match table
+void init_alarms(void);
+
+void alarm_get(uint8_t index, Alarm* alarm);
+
+//Store alarm and rebuild the match table
+//Call alarm_sync afterwards to pick the next alarm
+void alarm_set(uint8_t index, const Alarm* alarm);
+
+//Find the next alarm after the given minute of week
+//Call after boot and whenever the time is changed
+void alarm_sync(uint16_t minuteOfWeek);
+
+//Call on every minute rollover
+//Returns TRUE if an alarm fell due since the last check or sync,
+//alarms passed together by a missed rollover fire once
+uint8_t alarm_check(uint16_t minuteOfWeek);
+
+#endif	/* ALARM_H */
@@ -0,0 +1,40 @@
+/*
+ * File:   Bench.h
+ * Author: TallDwarf
+ *
+ * Cycle markers for simulator benchmarks, nothing is compiled in unless
+ * BENCH is defined. Each marker is one write of GPIOR0, which SimTrace.c
+ * has simavr record so tools/decode_trace.py can count the cycles between
+ */
+
+#ifndef BENCH_H
+#define	BENCH_H
+
+#include <avr/io.h>
+
+//Ids, tools/decode_trace.py has the matching names
+#define BENCH_UPDATE_TIME 1
+#define BENCH_UPDATE_MENU 2
+#define BENCH_RENDER 3
+#define BENCH_BRIGHTNESS 4
+#define BENCH_TIMER1_ISR 5
+#define BENCH_TIMER0_ISR 6
+//Set by whichever RTC backend is built so their traces line up
+#define BENCH_READ_TIME 7
+#define BENCH_READ_REGISTER 8
+//Reset to the first frame, and an injected hang to the reset it causes
+#define BENCH_BOOT 9
+#define BENCH_HANG 10
+
+//End markers carry the id with the top bit set
+#define BENCH_END_FLAG 0x80
+
+#ifdef BENCH
+#define BENCH_BEGIN(id) (GPIOR0 = (id))
+#define BENCH_END(id) (GPIOR0 = (id) | BENCH_END_FLAG)
+#else
+#define BENCH_BEGIN(id)
+#define BENCH_END(id)
+#endif
+
+#endif	/* BENCH_H */
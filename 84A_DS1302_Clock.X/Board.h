@@ -0,0 +1,125 @@
+/*
+ * File:   Board.h
+ * Author: TallDwarf
+ *
+ * Pin table for the board, one line per pin as (port letter, bit)
+ * Drivers take their pins from here and check at compile time which
+ * pins share a port so multi pin changes go out as one port write
+ */
+
+#ifndef BOARD_H
+#define	BOARD_H
+
+#include <avr/io.h>
+
+//RTC fitted to the board, Rtc.h picks the matching backend
+#define RTC_DS1302 1
+#define RTC_DS1307 2
+
+#ifndef RTC_BACKEND
+#define RTC_BACKEND RTC_DS1302
+#endif
+
+//Digit shift registers
+#define BOARD_DIGIT_DATA (A, 0)
+#define BOARD_DIGIT_CLOCK (A, 1)
+#define BOARD_DIGIT_LATCH (A, 2)
+#if RTC_BACKEND == RTC_DS1302
+#define BOARD_DIGIT_CLEAR (A, 4)
+#else
+//USCK is taken by the I2C clock
+#define BOARD_DIGIT_CLEAR (A, 7)
+#endif
+//Output enable, must be OC0A for PWM
+#define BOARD_DIGIT_OUTPUT (B, 2)
+
+//Light sensor, ADC3
+#define BOARD_BRIGHTNESS (A, 3)
+
+//Buttons, pulled HIGH and pressed LOW
+#define BOARD_LEFT_BUTTON (A, 5)
+#define BOARD_CENTER_BUTTON (B, 3)
+
+#if RTC_BACKEND == RTC_DS1302
+#define BOARD_RIGHT_BUTTON (A, 6)
+
+//DS1302
+#define BOARD_TIME_CE (A, 7)
+#define BOARD_TIME_CLOCK (B, 0)
+#define BOARD_TIME_DATA (B, 1)
+
+#define BOARD_TIME_OUTPUTS(port) \
+    (BOARD_MASK_ON(BOARD_TIME_CE, port) | BOARD_MASK_ON(BOARD_TIME_CLOCK, port) | \
+    BOARD_MASK_ON(BOARD_TIME_DATA, port))
+#else
+//DI is taken by the I2C data line
+#define BOARD_RIGHT_BUTTON (B, 0)
+
+//I2C RTC, fixed to the USI pins, open drain so never in BOARD_OUTPUTS
+#define BOARD_TIME_SCL (A, 4)
+#define BOARD_TIME_SDA (A, 6)
+
+#define BOARD_TIME_OUTPUTS(port) 0
+#endif
+
+//Port numbers, only used to compare ports
+#define BOARD_PORT_ID_A 1
+#define BOARD_PORT_ID_B 2
+
+//A pin travels as one (port, bit) argument and is unpacked last
+#define BOARD_PORT(pin) BOARD_PORT_ pin
+#define BOARD_DDR(pin) BOARD_DDR_ pin
+#define BOARD_PIN(pin) BOARD_PIN_ pin
+#define BOARD_BIT(pin) BOARD_BIT_ pin
+#define BOARD_ID(pin) BOARD_ID_ pin
+
+#define BOARD_PORT_(port, bit) PORT ## port
+#define BOARD_DDR_(port, bit) DDR ## port
+#define BOARD_PIN_(port, bit) PIN ## port
+#define BOARD_BIT_(port, bit) (bit)
+#define BOARD_ID_(port, bit) BOARD_PORT_ID_ ## port
+
+#define BOARD_MASK(pin) (1 << BOARD_BIT(pin))
+
+//Usable in #if as well as in code
+#define BOARD_SAME_PORT(a, b) (BOARD_ID(a) == BOARD_ID(b))
+
+//Mask of the pin if it sits on port, for building whole port values
+#define BOARD_MASK_ON(pin, port) ((BOARD_ID(pin) == BOARD_PORT_ID_ ## port) ? BOARD_MASK(pin) : 0)
+
+//Every pin driven by the MCU that sits on port, the rest are inputs
+#define BOARD_OUTPUTS(port) \
+    (BOARD_MASK_ON(BOARD_DIGIT_DATA, port) | BOARD_MASK_ON(BOARD_DIGIT_CLOCK, port) | \
+    BOARD_MASK_ON(BOARD_DIGIT_LATCH, port) | BOARD_MASK_ON(BOARD_DIGIT_CLEAR, port) | \
+    BOARD_MASK_ON(BOARD_DIGIT_OUTPUT, port) | BOARD_TIME_OUTPUTS(port))
+
+//Change two pins, one read-modify-write if they share a port
+//The port test is constant so only one branch is compiled in
+#define BOARD_REG_SET_2(reg, a, b) \
+    do { \
+        if(BOARD_SAME_PORT(a, b)) \
+            reg(a) |= BOARD_MASK(a) | BOARD_MASK(b); \
+        else \
+        { \
+            reg(a) |= BOARD_MASK(a); \
+            reg(b) |= BOARD_MASK(b); \
+        } \
+    } while(0)
+
+#define BOARD_REG_CLEAR_2(reg, a, b) \
+    do { \
+        if(BOARD_SAME_PORT(a, b)) \
+            reg(a) &= ~(BOARD_MASK(a) | BOARD_MASK(b)); \
+        else \
+        { \
+            reg(a) &= ~BOARD_MASK(a); \
+            reg(b) &= ~BOARD_MASK(b); \
+        } \
+    } while(0)
+
+#define BOARD_SET_2(a, b) BOARD_REG_SET_2(BOARD_PORT, a, b)
+#define BOARD_CLEAR_2(a, b) BOARD_REG_CLEAR_2(BOARD_PORT, a, b)
+#define BOARD_OUTPUT_2(a, b) BOARD_REG_SET_2(BOARD_DDR, a, b)
+#define BOARD_INPUT_2(a, b) BOARD_REG_CLEAR_2(BOARD_DDR, a, b)
+
+#endif	/* BOARD_H */
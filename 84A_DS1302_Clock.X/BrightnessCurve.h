@@ -0,0 +1,35 @@
+/*
+ * File:   BrightnessCurve.h
+ *
+ * Generated by tools/gen_brightness_curve.py - do not edit!
+ * Gamma 2.2, minimum duty 60, 2 dither bits
+ */
+
+#ifndef BRIGHTNESSCURVE_H
+#define	BRIGHTNESSCURVE_H
+
+#include <avr/pgmspace.h>
+
+#define BRIGHTNESS_DITHER_BITS 2
+
+const uint16_t brightness_curve[256] PROGMEM =
+{
+     240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,
+     240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  240,  246,  253,
+     261,  268,  275,  283,  290,  298,  305,  312,  319,  326,  333,  341,  348,  355,  362,  368,
+     375,  382,  389,  396,  402,  409,  416,  422,  429,  435,  442,  448,  455,  461,  467,  474,
+     480,  486,  492,  498,  504,  511,  517,  522,  528,  534,  540,  546,  552,  557,  563,  569,
+     574,  580,  586,  591,  597,  602,  607,  613,  618,  623,  629,  634,  639,  644,  649,  654,
+     659,  664,  669,  674,  679,  684,  688,  693,  698,  703,  707,  712,  716,  721,  725,  730,
+     734,  739,  743,  747,  752,  756,  760,  764,  768,  772,  776,  780,  784,  788,  792,  796,
+     800,  804,  807,  811,  815,  819,  822,  826,  829,  833,  836,  840,  843,  846,  850,  853,
+     856,  860,  863,  866,  869,  872,  875,  878,  881,  884,  887,  890,  893,  896,  898,  901,
+     904,  906,  909,  912,  914,  917,  919,  922,  924,  927,  929,  931,  934,  936,  938,  940,
+     943,  945,  947,  949,  951,  953,  955,  957,  959,  961,  962,  964,  966,  968,  970,  971,
+     973,  975,  976,  978,  979,  981,  982,  984,  985,  986,  988,  989,  990,  992,  993,  994,
+     995,  996,  998,  999, 1000, 1001, 1002, 1003, 1004, 1005, 1005, 1006, 1007, 1008, 1009, 1009,
+    1010, 1011, 1011, 1012, 1013, 1013, 1014, 1014, 1015, 1015, 1016, 1016, 1017, 1017, 1017, 1018,
+    1018, 1018, 1019, 1019, 1019, 1019, 1019, 1019, 1020, 1020, 1020, 1020, 1020, 1020, 1020, 1020
+};
+
+#endif	/* BRIGHTNESSCURVE_H */
@@ -0,0 +1,60 @@
+#include <avr/pgmspace.h>
+#include "Calendar.h"
+
+#define DAYS_IN_MONTH(m, leap) \
+    ((m) == 2 ? 28 + (leap) : ((m) == 4 || (m) == 6 || (m) == 9 || (m) == 11) ? 30 : 31)
+
+//Days before the first of the month
+#define DAYS_BEFORE(m, leap) \
+    (((m) > 1 ? DAYS_IN_MONTH(1, leap) : 0) + ((m) > 2 ? DAYS_IN_MONTH(2, leap) : 0) + \
+    ((m) > 3 ? DAYS_IN_MONTH(3, leap) : 0) + ((m) > 4 ? DAYS_IN_MONTH(4, leap) : 0) + \
+    ((m) > 5 ? DAYS_IN_MONTH(5, leap) : 0) + ((m) > 6 ? DAYS_IN_MONTH(6, leap) : 0) + \
+    ((m) > 7 ? DAYS_IN_MONTH(7, leap) : 0) + ((m) > 8 ? DAYS_IN_MONTH(8, leap) : 0) + \
+    ((m) > 9 ? DAYS_IN_MONTH(9, leap) : 0) + ((m) > 10 ? DAYS_IN_MONTH(10, leap) : 0) + \
+    ((m) > 11 ? DAYS_IN_MONTH(11, leap) : 0))
+
+#define MONTH_ROW(F, leap) \
+    { 0, F(1, leap), F(2, leap), F(3, leap), F(4, leap), F(5, leap), F(6, leap), \
+      F(7, leap), F(8, leap), F(9, leap), F(10, leap), F(11, leap), F(12, leap) }
+
+#define WEEKDAY_OFFSET(m, leap) (DAYS_BEFORE(m, leap) % 7)
+
+//[leap][month], month 0 unused
+static const uint8_t daysInMonth[2][13] PROGMEM =
+{
+    MONTH_ROW(DAYS_IN_MONTH, 0),
+    MONTH_ROW(DAYS_IN_MONTH, 1)
+};
+
+static const uint8_t weekdayOffset[2][13] PROGMEM =
+{
+    MONTH_ROW(WEEKDAY_OFFSET, 0),
+    MONTH_ROW(WEEKDAY_OFFSET, 1)
+};
+
+//x % 7 for x < 256 without division, 8 = 1 (mod 7)
+static inline uint8_t mod7(uint8_t x)
+{
+    x = (x >> 3) + (x & 0x07);
+    x = (x >> 3) + (x & 0x07);
+    
+    return (x >= 7) ? x - 7 : x;
+}
+
+uint8_t calendar_days_in_month(uint8_t year, uint8_t month)
+{
+    return pgm_read_byte(&daysInMonth[IS_LEAP_YEAR(year)][month]);
+}
+
+uint8_t calendar_weekday(uint8_t year, uint8_t month, uint8_t date)
+{
+    //365 = 1 (mod 7) so every year moves the weekday by one,
+    //plus one for each leap year before this one
+    uint8_t offset = year + ((year + 3) >> 2);
+    
+    offset += pgm_read_byte(&weekdayOffset[IS_LEAP_YEAR(year)][month]);
+    offset += date - 1;
+    offset += CALENDAR_EPOCH_DAY - 1;
+    
+    return mod7(offset) + 1;
+}
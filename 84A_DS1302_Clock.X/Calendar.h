@@ -0,0 +1,29 @@
+/*
+ * File:   Calendar.h
+ * Author: TallDwarf
+ *
+ * Date helpers for the DS1302 range, 2000 - 2099
+ * Every year divisible by 4 is a leap year in this range
+ */
+
+#ifndef CALENDAR_H
+#define	CALENDAR_H
+
+#include <avr/io.h>
+
+//DS1302 day number given to 2000-01-01, a Saturday
+//6 = weeks start on Monday, 7 = weeks start on Sunday
+#ifndef CALENDAR_EPOCH_DAY
+#define CALENDAR_EPOCH_DAY 6
+#endif
+
+#define IS_LEAP_YEAR(year) (((year) & 0x03) == 0)
+
+//year 0 - 99, month 1 - 12
+uint8_t calendar_days_in_month(uint8_t year, uint8_t month);
+
+//year 0 - 99, month 1 - 12, date 1 - 31
+//Returns DS1302 day 1 - 7
+uint8_t calendar_weekday(uint8_t year, uint8_t month, uint8_t date);
+
+#endif	/* CALENDAR_H */
@@ -1,33 +1,226 @@
 #include "DS1302.h"
+#include "Bench.h"
 
-void init_ds1302(uint8_t* time)
+//BCD byte holding a value between min and max
+static uint8_t is_bcd_in_range(uint8_t value, uint8_t min, uint8_t max)
+{
+    if((value & 0x0F) > 9)
+        return 0;
+    
+    value = COMBINE((value >> 4), (value & 0x0F));
+    
+    return value >= min && value <= max;
+}
+
+uint8_t is_valid_clock_ds1302(uint8_t* time)
+{
+    uint8_t hour = time[DS1302_IMAGE_HOUR];
+    
+    if(IS_24_HOUR(time))
+    {
+        if(!is_bcd_in_range(hour & 0x3F, 0, 23))
+            return 0;
+    }
+    else if(!is_bcd_in_range(hour & 0x1F, 1, 12))
+        return 0;
+    
+    //The menu halts the clock too, so the halt bit says nothing here
+    return is_bcd_in_range(time[DS1302_IMAGE_SECOND] & 0x7F, 0, 59) &&
+            is_bcd_in_range(time[DS1302_IMAGE_MINUTE], 0, 59) &&
+            is_bcd_in_range(time[DS1302_IMAGE_DATE], 1, 31) &&
+            is_bcd_in_range(time[DS1302_IMAGE_MONTH], 1, 12) &&
+            is_bcd_in_range(time[DS1302_IMAGE_DAY], 1, 7) &&
+            is_bcd_in_range(time[DS1302_IMAGE_YEAR], 0, 99);
+}
+
+//The rest is the DS1302 driver, built only for boards fitted with one
+#if RTC_BACKEND == RTC_DS1302
+
+typedef struct
+{
+    uint8_t address;
+    uint8_t data;
+} DS1302_WRITE;
+
+static DS1302_WRITE queue[DS1302_QUEUE_SIZE];
+static uint8_t queued = 0;
+
+//Set by a queued write that has to go out at the next commit
+static uint8_t commitDue = 0;
+
+void init_ds1302_pins(void)
 {
     //Set pins as output
     TIME_CE_DDR |= (1 << TIME_CE);
-    TIME_CLOCK_DDR |= (1 << TIME_CLOCK);
-    TIME_DATA_DDR |= (1 << TIME_DATA);
+    BOARD_OUTPUT_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
     
     //Set all pins to LOW
     TIME_CE_PORT &= ~((1 << TIME_CE));
-    TIME_CLOCK_PORT &= ~(1 << TIME_CLOCK);
-    TIME_DATA_PORT &= ~(1 << TIME_DATA);
-   
-    //Disable write protection and trickle charge
-    write_to_ds1302(DS1302_WRITE_PROTECTION, 0x00);
-    write_to_ds1302(DS1302_TRICKLE_CHARGE, 0x00);
+    BOARD_CLEAR_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
+}
+
+void release_ds1302_pins(void)
+{
+    //LOW first so no pull ups are left on once they are inputs
+    TIME_CE_PORT &= ~((1 << TIME_CE));
+    BOARD_CLEAR_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
+    
+    TIME_CE_DDR &= ~(1 << TIME_CE);
+    BOARD_INPUT_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
+}
+
+uint8_t init_ds1302(uint8_t* time)
+{
+    uint8_t clock[8];
+    
+    init_ds1302_pins();
+    
+    //Single burst, nothing is written so the first frame is not held up
+    burst_read_from_ds1302(clock);
+    
+    if(!is_valid_clock_ds1302(clock))
+        return 0;
+    
+    for(uint8_t i = 0; i < 8; ++i)
+        time[i] = clock[i];
+    
+    return 1;
+}
+
+uint8_t is_valid_trickle_ds1302(uint8_t setting)
+{
+    //Anything that is not enabled just disables charging
+    return IS_VALID_TRICKLE(setting);
+}
+
+uint8_t set_trickle_charge_ds1302(uint8_t setting)
+{
+    if(!is_valid_trickle_ds1302(setting))
+        return 0;
+    
+    uint8_t current;
+    read_from_address_ds1302(DS1302_TRICKLE_CHARGE, &current);
     
-    //Read current date/time from ds1302
-    //burst_read_from_ds1302(time);
+    //All disabled patterns are equivalent
+    if(current == setting || (!IS_TRICKLE_ENABLED(current) && !IS_TRICKLE_ENABLED(setting)))
+        return 1;
     
-    //Testing
-    burst_write_to_ds1302(time);
+    queue_write_ds1302(DS1302_TRICKLE_CHARGE, setting);
+    return 1;
+}
+
+void protect_ds1302(void)
+{
+    write_to_ds1302(DS1302_WRITE_PROTECTION, DS1302_PROTECT);
+}
+
+void unprotect_ds1302(void)
+{
+    write_to_ds1302(DS1302_WRITE_PROTECTION, DS1302_UNPROTECT);
+}
+
+static void queue_entry(uint8_t address, uint8_t data)
+{
+    for(uint8_t i = 0; i < queued; ++i)
+    {
+        if(queue[i].address == address)
+        {
+            queue[i].data = data;
+            return;
+        }
+    }
+    
+    if(queued == DS1302_QUEUE_SIZE)
+        flush_ds1302();
+    
+    queue[queued].address = address;
+    queue[queued].data = data;
+    queued++;
+}
+
+void queue_write_ds1302(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+    commitDue = 1;
+}
+
+void queue_deferred_ds1302(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+}
+
+void queue_clock_ds1302(uint8_t* time)
+{
+    //All seven have to reach one commit or the stored time can tear
+    if(queued > DS1302_QUEUE_SIZE - 7)
+        flush_ds1302();
+    
+    for(uint8_t address = DS1302_SECOND; address <= DS1302_YEAR; address += 2)
+    {
+        queue_write_ds1302(address, *time);
+        time++;
+    }
+}
+
+void commit_ds1302(void)
+{
+    if(commitDue)
+        flush_ds1302();
+}
+
+void flush_ds1302(void)
+{
+    if(queued == 0)
+        return;
+    
+    //Clock burst image, last byte turns write protection back on
+    uint8_t image[8];
+    uint8_t clockMask = 0;
+    
+    image[7] = DS1302_PROTECT;
+    
+    unprotect_ds1302();
+    
+    for(uint8_t i = 0; i < queued; ++i)
+    {
+        uint8_t address = queue[i].address;
+        
+        if(address >= DS1302_SECOND && address <= DS1302_YEAR)
+        {
+            uint8_t index = (address - DS1302_SECOND) >> 1;
+            
+            image[index] = queue[i].data;
+            clockMask |= (1 << index);
+        }
+        else
+        {
+            write_to_ds1302(address, queue[i].data);
+        }
+    }
+    
+    if(clockMask == 0x7F)
+    {
+        burst_write_to_ds1302(image);
+    }
+    else
+    {
+        for(uint8_t index = 0; index < 7; ++index)
+        {
+            if(clockMask & (1 << index))
+                write_to_ds1302(DS1302_SECOND + (index << 1), image[index]);
+        }
+        
+        protect_ds1302();
+    }
+    
+    queued = 0;
+    commitDue = 0;
 }
 
 void start_ds1302(void)
 {
     //Set LOW for transmission
-    TIME_CLOCK_PORT &= ~(1 << TIME_CLOCK);
-    TIME_DATA_PORT &= ~(1 << TIME_DATA);
+    BOARD_CLEAR_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
     TIME_CE_PORT &= ~(1 << TIME_CE);
     
     //Small delay then start transmission
@@ -44,8 +237,7 @@ void stop_ds1302(void)
     NOP2();
     
     //Set clock and data to LOW ready for next transmission
-    TIME_CLOCK_PORT &= ~(1 << TIME_CLOCK);
-    TIME_DATA_PORT &= ~(1 << TIME_DATA);
+    BOARD_CLEAR_2(BOARD_TIME_CLOCK, BOARD_TIME_DATA);
 }
 
 void write_byte_to_ds1302(uint8_t data)
@@ -53,24 +245,34 @@ void write_byte_to_ds1302(uint8_t data)
     //Set time data as output
     TIME_DATA_DDR |= (1 << TIME_DATA);
     
+#if TIME_BUS_SHARED
+    //Port value with clock and data LOW, nothing else on the port
+    //changes while a transfer is running
+    uint8_t idle = TIME_CLOCK_PORT & ~((1 << TIME_CLOCK) | (1 << TIME_DATA));
+#endif
+    
     for(uint8_t i = 0; i < 8; ++i)
     {
+#if TIME_BUS_SHARED
+        //Clock LOW and data set in a single port write
+        TIME_CLOCK_PORT = (data & 0x01) ? (idle | (1 << TIME_DATA)) : idle;
+#else
         //Clock to LOW
         TIME_CLOCK_PORT &= ~(1 << TIME_CLOCK);
-        NOP2();
         
         //Set data
-        if(data & (0x01 << i))
+        if(data & 0x01)
             TIME_DATA_PORT |= (1 << TIME_DATA);
         else
             TIME_DATA_PORT &= ~(1 << TIME_DATA);
+#endif
+        data >>= 1;
         
-        //Clock HIGH
+        //Toggle clock HIGH
         //ds1302 reads on LOW to HIGH
         NOP2();
-        TIME_CLOCK_PORT |= (1 << TIME_CLOCK);
+        TIME_CLOCK_PIN = (1 << TIME_CLOCK);
         NOP2();
-        
     }
 }
 
@@ -84,29 +286,33 @@ void write_to_ds1302(uint8_t address, uint8_t data)
 
 void read_byte_from_ds1302(uint8_t* data)
 {
+    uint8_t value = 0x00;
+    
     //Set time data as input
     TIME_DATA_DDR &= ~(1 << TIME_DATA);
     TIME_DATA_PORT &= ~(1 << TIME_DATA);
     NOP();
     
-    //Clear data
-    *data = 0x00;
-    
+    //Clock is left HIGH by the byte before so toggles alternate LOW, HIGH
     for(uint8_t i = 0; i <= 7; ++i)
     {
-        TIME_CLOCK_PORT &= ~(1 << TIME_CLOCK);
+        //ds1302 presents the next bit on HIGH to LOW
+        TIME_CLOCK_PIN = (1 << TIME_CLOCK);
         NOP2();
         
-        TIME_CLOCK_PORT |= (1 << TIME_CLOCK);
+        TIME_CLOCK_PIN = (1 << TIME_CLOCK);
         NOP2();
         
         if(bit_is_set(TIME_DATA_PIN, TIME_DATA))
-            *data |= (1 << i);      
+            value |= (1 << i);      
     }
+    
+    *data = value;
 }
 
 void burst_read_from_ds1302(uint8_t* ds1302_data)
 {
+    BENCH_BEGIN(BENCH_READ_TIME);
     start_ds1302();
     write_byte_to_ds1302(READ_ADDRESS(DS1302_CLOCK_BURST));
     
@@ -117,6 +323,7 @@ void burst_read_from_ds1302(uint8_t* ds1302_data)
     }
     
     stop_ds1302();
+    BENCH_END(BENCH_READ_TIME);
 }
 
 void burst_write_to_ds1302(uint8_t* time)
@@ -133,13 +340,76 @@ void burst_write_to_ds1302(uint8_t* time)
     stop_ds1302();
 }
 
+void burst_read_ram_ds1302(uint8_t* data, uint8_t count)
+{
+    start_ds1302();
+    write_byte_to_ds1302(READ_ADDRESS(DS1302_RAM_BURST));
+    
+    for(uint8_t i = 0; i < count; ++i)
+    {
+        read_byte_from_ds1302(data);
+        data++;
+    }
+    
+    stop_ds1302();
+}
+
+//Unlike the clock burst RAM does not need all bytes written
+void burst_write_ram_ds1302(uint8_t* data, uint8_t count)
+{
+    start_ds1302();
+    write_byte_to_ds1302(DS1302_RAM_BURST);
+    
+    for(uint8_t i = 0; i < count; ++i)
+    {
+        write_byte_to_ds1302(*data);
+        data++;
+    }
+    
+    stop_ds1302();
+}
+
+void read_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count)
+{
+    //Bursts always start at byte 0
+    if(index == 0)
+    {
+        burst_read_ram_ds1302(data, count);
+        return;
+    }
+    
+    for(uint8_t i = 0; i < count; ++i)
+        read_from_address_ds1302(DS1302_RAM(index + i), &data[i]);
+}
+
+void write_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count)
+{
+    unprotect_ds1302();
+    
+    if(index == 0)
+    {
+        burst_write_ram_ds1302(data, count);
+    }
+    else
+    {
+        for(uint8_t i = 0; i < count; ++i)
+            write_to_ds1302(DS1302_RAM(index + i), data[i]);
+    }
+    
+    protect_ds1302();
+}
+
 void read_from_address_ds1302(uint8_t address, uint8_t* data)
 {    
     //Set address r/w bit to read
     address = READ_ADDRESS(address);
     
+    BENCH_BEGIN(BENCH_READ_REGISTER);
     start_ds1302();
     write_byte_to_ds1302(address);
     read_byte_from_ds1302(data);
     stop_ds1302();
-}
\ No newline at end of file
+    BENCH_END(BENCH_READ_REGISTER);
+}
+
+#endif
\ No newline at end of file
@@ -10,45 +10,25 @@
 
 #include <avr/io.h>
 
-#ifndef TIME_CE
-#define TIME_CE PORTA7
-#endif
-
-#ifndef TIME_CE_PORT
-#define TIME_CE_PORT PORTA
-#endif
-
-#ifndef TIME_CE_DDR
-#define TIME_CE_DDR DDRA
-#endif
-
-#ifndef TIME_CLOCK
-#define TIME_CLOCK PORTB0
-#endif
-
-#ifndef TIME_CLOCK_PORT
-#define TIME_CLOCK_PORT PORTB
-#endif
+#include "Board.h"
 
-#ifndef TIME_CLOCK_DDR
-#define TIME_CLOCK_DDR DDRB
-#endif
-
-#ifndef TIME_DATA
-#define TIME_DATA PORTB1
-#endif
+//Pins come from the board table
+#define TIME_CE BOARD_BIT(BOARD_TIME_CE)
+#define TIME_CE_PORT BOARD_PORT(BOARD_TIME_CE)
+#define TIME_CE_DDR BOARD_DDR(BOARD_TIME_CE)
 
-#ifndef TIME_DATA_PORT
-#define TIME_DATA_PORT PORTB
-#endif
+#define TIME_CLOCK BOARD_BIT(BOARD_TIME_CLOCK)
+#define TIME_CLOCK_PORT BOARD_PORT(BOARD_TIME_CLOCK)
+#define TIME_CLOCK_DDR BOARD_DDR(BOARD_TIME_CLOCK)
+#define TIME_CLOCK_PIN BOARD_PIN(BOARD_TIME_CLOCK)
 
-#ifndef TIME_DATA_DDR
-#define TIME_DATA_DDR DDRB
-#endif
+#define TIME_DATA BOARD_BIT(BOARD_TIME_DATA)
+#define TIME_DATA_PORT BOARD_PORT(BOARD_TIME_DATA)
+#define TIME_DATA_DDR BOARD_DDR(BOARD_TIME_DATA)
+#define TIME_DATA_PIN BOARD_PIN(BOARD_TIME_DATA)
 
-#ifndef TIME_DATA_PIN
-#define TIME_DATA_PIN PINB
-#endif
+//Clock and data on one port, a bit is presented with a single port write
+#define TIME_BUS_SHARED BOARD_SAME_PORT(BOARD_TIME_CLOCK, BOARD_TIME_DATA)
 
 #define NOP() asm("nop")
 #define NOP2() NOP(); NOP()
@@ -69,6 +49,10 @@
 
 #define DS1302_CLOCK_BURST 0xBE
 
+//Write protection register value, bit 7 set blocks all writes
+#define DS1302_PROTECT 0x80
+#define DS1302_UNPROTECT 0x00
+
 //Starting point each other point is 0xC0 + (N * 2)
 //0 - 30
 #define DS1302_RAM_START 0xC0
@@ -76,8 +60,41 @@
 
 #define DS1302_RAM_BURST 0xFE
 
+#define DS1302_RAM_SIZE 31
+
+//Write address of RAM byte N
+#define DS1302_RAM(n) (DS1302_RAM_START + ((n) << 1))
+
 #define DS1302_READBIT 0
 
+//Trickle charge register
+//TCS (7-4) must be 1010 to enable, any other pattern disables charging
+//DS (3-2) diodes, RS (1-0) resistor, 00 in either (or DS = 11) is invalid
+#define DS1302_TRICKLE_ENABLE 0xA0
+#define DS1302_TRICKLE_ENABLE_MASK 0xF0
+
+//Power on default
+#define DS1302_TRICKLE_OFF 0x5C
+
+#define DS1302_DIODES_1 0x04
+#define DS1302_DIODES_2 0x08
+#define DS1302_DIODES_MASK 0x0C
+
+#define DS1302_RESISTOR_2K 0x01
+#define DS1302_RESISTOR_4K 0x02
+#define DS1302_RESISTOR_8K 0x03
+#define DS1302_RESISTOR_MASK 0x03
+
+#define DS1302_TRICKLE(diodes, resistor) (DS1302_TRICKLE_ENABLE | (diodes) | (resistor))
+
+#define IS_TRICKLE_ENABLED(setting) (((setting) & DS1302_TRICKLE_ENABLE_MASK) == DS1302_TRICKLE_ENABLE)
+
+//Disabled, or enabled with one or two diodes and a resistor
+//Constant settings can be checked with #if
+#define IS_VALID_TRICKLE(setting) (!IS_TRICKLE_ENABLED(setting) || \
+    ((((setting) & DS1302_DIODES_MASK) == DS1302_DIODES_1 || ((setting) & DS1302_DIODES_MASK) == DS1302_DIODES_2) && \
+    ((setting) & DS1302_RESISTOR_MASK) != 0))
+
 #define READ_ADDRESS(address) (address | (1 << DS1302_READBIT))
 
 #define GET_X10(h) ((h) / 10)
@@ -87,7 +104,53 @@
 #define HOUR_24_COMBINE(h, l, t) (l | (h << 4))
 #define HOUR_12_COMBINE(h, l, ampm) (l | (h << 4) | (ampm << 5) | (1 << 7))
 
-#define IS_24_HOUR(time) (time.H24.hour_12_24 == 0)  
+//Register image, one byte per clock register in burst order plus trickle charge
+//Same bytes as DS1302_DATA_SET without bitfield access
+#define DS1302_IMAGE_SECOND 0
+#define DS1302_IMAGE_MINUTE 1
+#define DS1302_IMAGE_HOUR 2
+#define DS1302_IMAGE_DATE 3
+#define DS1302_IMAGE_MONTH 4
+#define DS1302_IMAGE_DAY 5
+#define DS1302_IMAGE_YEAR 6
+#define DS1302_IMAGE_WRITE_PROTECTION 7
+#define DS1302_IMAGE_TRICKLE_CHARGE 8
+
+#define DS1302_IMAGE_SIZE 9
+
+//Fields as image byte, shift, mask
+#define DS1302_F_SECONDS DS1302_IMAGE_SECOND, 0, 0x0F
+#define DS1302_F_SECONDS_X10 DS1302_IMAGE_SECOND, 4, 0x07
+#define DS1302_F_CLOCK_HALT DS1302_IMAGE_SECOND, 7, 0x01
+#define DS1302_F_MINUTES DS1302_IMAGE_MINUTE, 0, 0x0F
+#define DS1302_F_MINUTES_X10 DS1302_IMAGE_MINUTE, 4, 0x07
+#define DS1302_F_HOUR DS1302_IMAGE_HOUR, 0, 0x0F
+#define DS1302_F_HOUR24_X10 DS1302_IMAGE_HOUR, 4, 0x03
+#define DS1302_F_HOUR12_X10 DS1302_IMAGE_HOUR, 4, 0x01
+#define DS1302_F_AM_PM DS1302_IMAGE_HOUR, 5, 0x01
+//1 = 12 hour mode
+#define DS1302_F_HOUR_MODE DS1302_IMAGE_HOUR, 7, 0x01
+#define DS1302_F_DATE DS1302_IMAGE_DATE, 0, 0x0F
+#define DS1302_F_DATE_X10 DS1302_IMAGE_DATE, 4, 0x03
+#define DS1302_F_MONTH DS1302_IMAGE_MONTH, 0, 0x0F
+#define DS1302_F_MONTH_X10 DS1302_IMAGE_MONTH, 4, 0x01
+#define DS1302_F_DAY DS1302_IMAGE_DAY, 0, 0x07
+#define DS1302_F_YEAR DS1302_IMAGE_YEAR, 0, 0x0F
+#define DS1302_F_YEAR_X10 DS1302_IMAGE_YEAR, 4, 0x0F
+#define DS1302_F_WRITE_PROTECTION DS1302_IMAGE_WRITE_PROTECTION, 7, 0x01
+#define DS1302_F_TRICKLE_CHARGE DS1302_IMAGE_TRICKLE_CHARGE, 0, 0xFF
+
+//Extra level so the field expands into byte, shift, mask first
+#define DS1302_GET(image, field) DS1302_GET_FIELD(image, field)
+#define DS1302_SET(image, field, value) DS1302_SET_FIELD(image, field, value)
+#define DS1302_TOGGLE(image, field) DS1302_TOGGLE_FIELD(image, field)
+
+#define DS1302_GET_FIELD(image, byte, shift, mask) (((image)[byte] >> (shift)) & (mask))
+#define DS1302_SET_FIELD(image, byte, shift, mask, value) \
+    ((image)[byte] = ((image)[byte] & ~((mask) << (shift))) | (((value) & (mask)) << (shift)))
+#define DS1302_TOGGLE_FIELD(image, byte, shift, mask) ((image)[byte] ^= ((mask) << (shift)))
+
+#define IS_24_HOUR(image) (DS1302_GET(image, DS1302_F_HOUR_MODE) == 0)
 
 typedef struct {
     unsigned char seconds : 4;
@@ -141,7 +204,20 @@ typedef struct {
     unsigned char trickleCharger : 8;
 } DS1302_DATA_SET;
 
-void init_ds1302(uint8_t* time);
+//Read the clock into the register image time
+//Returns FALSE and leaves time untouched if the clock holds values out
+//of range, time then still has to be written. A halted clock is read
+//like a running one, halt bit included
+uint8_t init_ds1302(uint8_t* time);
+
+//Every register a valid BCD value, halted or not
+//Works on the register image so every RTC backend shares it
+uint8_t is_valid_clock_ds1302(uint8_t* time);
+
+//Drive the bus pins LOW, or release them as inputs with no pull ups
+//CE has a pull down inside the DS1302 so released means idle
+void init_ds1302_pins(void);
+void release_ds1302_pins(void);
 
 void start_ds1302(void);
 void stop_ds1302(void);
@@ -155,4 +231,56 @@ void read_from_address_ds1302(uint8_t address, uint8_t* data);
 void burst_read_from_ds1302(uint8_t* ds1302_data);
 void burst_write_to_ds1302(uint8_t* ds1302_data);
 
+//Returns FALSE for enabled patterns the datasheet does not allow
+uint8_t is_valid_trickle_ds1302(uint8_t setting);
+
+//Read back the register and queue a write only if the setting differs
+//Returns FALSE and leaves the register alone if setting is invalid
+uint8_t set_trickle_charge_ds1302(uint8_t setting);
+
+//Transactions
+//Writes are queued then sent with write protection lifted only for the commit
+//If all seven time registers are queued they go as one clock burst that
+//also re-asserts write protection in its last byte
+
+#ifndef DS1302_QUEUE_SIZE
+#define DS1302_QUEUE_SIZE 12
+#endif
+
+#if DS1302_QUEUE_SIZE < 7
+#error "Write queue must hold a whole clock"
+#endif
+
+//Queue a register or RAM write, an already queued address is replaced
+//Sends everything queued first if the queue is full
+void queue_write_ds1302(uint8_t address, uint8_t data);
+
+//Queue a write that waits for the next commit that has a queued write
+//to send anyway, or for a flush
+void queue_deferred_ds1302(uint8_t address, uint8_t data);
+
+//Queue the seven time registers from a clock image
+//Sends the queue first if they would not all fit, so they go out together
+void queue_clock_ds1302(uint8_t* time);
+
+//Send everything queued and leave the DS1302 write protected
+//Does nothing while only deferred writes are queued
+void commit_ds1302(void);
+
+//Send everything queued, deferred writes too
+void flush_ds1302(void);
+
+//For bulk transfers outside the queue
+void protect_ds1302(void);
+void unprotect_ds1302(void);
+
+//Read/Write RAM from byte 0, count up to DS1302_RAM_SIZE
+void burst_read_ram_ds1302(uint8_t* data, uint8_t count);
+void burst_write_ram_ds1302(uint8_t* data, uint8_t count);
+
+//Read/Write count RAM bytes from byte index, a burst when index is 0
+//Writes go straight out, not through the queue
+void read_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count);
+void write_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count);
+
 #endif	/* DS1302_H */
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "Board.h"
+
+//Only built for boards fitted with one
+#if RTC_BACKEND == RTC_DS1307
+
+#include "DS1307.h"
+#include "Bench.h"
+
+typedef struct
+{
+    uint8_t address;
+    uint8_t data;
+} DS1307_WRITE;
+
+static DS1307_WRITE queue[DS1307_QUEUE_SIZE];
+static uint8_t queued = 0;
+
+//Set by a queued write that has to go out at the next commit
+static uint8_t commitDue = 0;
+
+//Register of each clock byte in DS1302 image order
+static const uint8_t clockRegister[DS1307_CLOCK_SIZE] =
+{
+    DS1307_SECOND, DS1307_MINUTE, DS1307_HOUR, DS1307_DATE, DS1307_MONTH, DS1307_DAY, DS1307_YEAR
+};
+
+//Start a write at address, FALSE if the chip did not answer
+static uint8_t begin_write(uint8_t address)
+{
+    if(!usi_twi_start(DS1307_WRITE_ADDRESS))
+        return 0;
+    
+    if(usi_twi_write(address))
+        return 1;
+    
+    usi_twi_stop();
+    return 0;
+}
+
+static uint8_t read_registers(uint8_t address, uint8_t* data, uint8_t count)
+{
+    if(count == 0)
+        return 1;
+    
+    if(!begin_write(address))
+        return 0;
+    
+    //Repeated start turns the bus round without releasing it
+    if(!usi_twi_start(DS1307_READ_ADDRESS))
+        return 0;
+    
+    for(uint8_t i = 0; i < count; ++i)
+        data[i] = usi_twi_read(i == count - 1);
+    
+    usi_twi_stop();
+    return 1;
+}
+
+static uint8_t read_clock(uint8_t* time)
+{
+    uint8_t clock[DS1307_CLOCK_SIZE];
+    
+    if(!read_registers(DS1307_SECOND, clock, DS1307_CLOCK_SIZE))
+        return 0;
+    
+    for(uint8_t i = 0; i < DS1307_CLOCK_SIZE; ++i)
+        time[i] = clock[clockRegister[i]];
+    
+    time[DS1302_IMAGE_HOUR] = DS1307_HOUR_TO_IMAGE(time[DS1302_IMAGE_HOUR]);
+    time[DS1302_IMAGE_WRITE_PROTECTION] = DS1302_UNPROTECT;
+    
+    return 1;
+}
+
+uint8_t init_ds1307(uint8_t* time)
+{
+    uint8_t clock[8];
+    
+    init_usi_twi();
+    
+    if(!read_clock(clock) || !is_valid_clock_ds1302(clock))
+        return 0;
+    
+    for(uint8_t i = 0; i < 8; ++i)
+        time[i] = clock[i];
+    
+    return 1;
+}
+
+void read_time_ds1307(uint8_t* time)
+{
+    BENCH_BEGIN(BENCH_READ_TIME);
+    read_clock(time);
+    BENCH_END(BENCH_READ_TIME);
+}
+
+void read_from_address_ds1307(uint8_t address, uint8_t* data)
+{
+    BENCH_BEGIN(BENCH_READ_REGISTER);
+    read_registers(address, data, 1);
+    BENCH_END(BENCH_READ_REGISTER);
+}
+
+void read_ram_ds1307(uint8_t index, uint8_t* data, uint8_t count)
+{
+    read_registers(DS1307_RAM(index), data, count);
+}
+
+void write_ram_ds1307(uint8_t index, uint8_t* data, uint8_t count)
+{
+    if(!begin_write(DS1307_RAM(index)))
+        return;
+    
+    for(uint8_t i = 0; i < count; ++i)
+        usi_twi_write(data[i]);
+    
+    usi_twi_stop();
+}
+
+static void queue_entry(uint8_t address, uint8_t data)
+{
+    for(uint8_t i = 0; i < queued; ++i)
+    {
+        if(queue[i].address == address)
+        {
+            queue[i].data = data;
+            return;
+        }
+    }
+    
+    if(queued == DS1307_QUEUE_SIZE)
+        flush_ds1307();
+    
+    queue[queued].address = address;
+    queue[queued].data = data;
+    queued++;
+}
+
+void queue_write_ds1307(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+    commitDue = 1;
+}
+
+void queue_deferred_ds1307(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+}
+
+void queue_clock_ds1307(uint8_t* time)
+{
+    //All of the clock has to reach one commit or the stored time can tear
+    if(queued > DS1307_QUEUE_SIZE - DS1307_CLOCK_SIZE)
+        flush_ds1307();
+    
+    for(uint8_t i = 0; i < DS1307_CLOCK_SIZE; ++i)
+    {
+        uint8_t data = time[i];
+        
+        if(i == DS1302_IMAGE_HOUR)
+            data = DS1307_HOUR_FROM_IMAGE(data);
+        
+        queue_write_ds1307(clockRegister[i], data);
+    }
+}
+
+void commit_ds1307(void)
+{
+    if(commitDue)
+        flush_ds1307();
+}
+
+void flush_ds1307(void)
+{
+    //Sort by register, at most a queue full of entries
+    for(uint8_t i = 1; i < queued; ++i)
+    {
+        DS1307_WRITE write = queue[i];
+        uint8_t j = i;
+        
+        for(; j > 0 && queue[j - 1].address > write.address; --j)
+            queue[j] = queue[j - 1];
+        
+        queue[j] = write;
+    }
+    
+    uint8_t i = 0;
+    
+    while(i < queued)
+    {
+        //A chip that does not answer drops the run
+        uint8_t open = begin_write(queue[i].address);
+        
+        do
+        {
+            if(open)
+                usi_twi_write(queue[i].data);
+            
+            i++;
+        }
+        while(i < queued && queue[i].address == queue[i - 1].address + 1);
+        
+        if(open)
+            usi_twi_stop();
+    }
+    
+    queued = 0;
+    commitDue = 0;
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * File:   DS1307.h
+ * Author: TallDwarf
+ *
+ * DS1307 I2C RTC on the USI, the DS1338 is register compatible
+ * Reads and writes the same register image as DS1302.h so the rest of
+ * the clock does not see which chip is fitted
+ */
+
+#ifndef DS1307_H
+#define	DS1307_H
+
+#include <avr/io.h>
+
+#include "DS1302.h"
+#include "UsiTwi.h"
+
+//7 bit bus address
+#define DS1307_ADDRESS 0x68
+#define DS1307_WRITE_ADDRESS ((DS1307_ADDRESS << 1) | USI_TWI_WRITE)
+#define DS1307_READ_ADDRESS ((DS1307_ADDRESS << 1) | USI_TWI_READ)
+
+//Registers, the pointer moves on by one after every byte
+#define DS1307_SECOND 0x00
+#define DS1307_MINUTE 0x01
+#define DS1307_HOUR 0x02
+#define DS1307_DAY 0x03
+#define DS1307_DATE 0x04
+#define DS1307_MONTH 0x05
+#define DS1307_YEAR 0x06
+#define DS1307_CONTROL 0x07
+
+#define DS1307_CLOCK_SIZE 7
+
+//Hour register 12 hour flag, bit 7 in the DS1302 image
+#define DS1307_HOUR_12 0x40
+
+//Hour between register and image, everything but the flag lines up
+#define DS1307_HOUR_TO_IMAGE(hour) (((hour) & 0x3F) | (((hour) & DS1307_HOUR_12) << 1))
+#define DS1307_HOUR_FROM_IMAGE(hour) (((hour) & 0x3F) | (((hour) & 0x80) >> 1))
+
+//Battery backed RAM after the control register
+#define DS1307_RAM_START 0x08
+#define DS1307_RAM_SIZE 56
+
+//Register of RAM byte N
+#define DS1307_RAM(n) (DS1307_RAM_START + (n))
+
+//Same as init_ds1302, also FALSE if the chip does not answer
+uint8_t init_ds1307(uint8_t* time);
+
+//Clock into the first 8 bytes of a register image in one transaction
+//The image write protection byte is always clear, the DS1307 has none
+//time is left untouched if the chip does not answer
+void read_time_ds1307(uint8_t* time);
+
+//Single register, address as in the DS1307 datasheet
+void read_from_address_ds1307(uint8_t address, uint8_t* data);
+
+//Read/Write count RAM bytes from byte index in one transaction
+//Writes go straight out, not through the queue
+void read_ram_ds1307(uint8_t index, uint8_t* data, uint8_t count);
+void write_ram_ds1307(uint8_t index, uint8_t* data, uint8_t count);
+
+//Transactions
+//Writes are queued then sent sorted by register, each run of
+//consecutive registers as one write, so a full clock can not tear
+
+#ifndef DS1307_QUEUE_SIZE
+#define DS1307_QUEUE_SIZE 12
+#endif
+
+#if DS1307_QUEUE_SIZE < DS1307_CLOCK_SIZE
+#error "Write queue must hold a whole clock"
+#endif
+
+//Queue a register or RAM write, an already queued address is replaced
+//Sends everything queued first if the queue is full
+void queue_write_ds1307(uint8_t address, uint8_t data);
+
+//Queue a write that waits for the next commit that has a queued write
+//to send anyway, or for a flush
+void queue_deferred_ds1307(uint8_t address, uint8_t data);
+
+//Queue the seven time registers from a clock image
+//Sends the queue first if they would not all fit, so they go out together
+void queue_clock_ds1307(uint8_t* time);
+
+//Send everything queued
+//Does nothing while only deferred writes are queued
+void commit_ds1307(void);
+
+//Send everything queued, deferred writes too
+void flush_ds1307(void);
+
+#endif	/* DS1307_H */
@@ -0,0 +1,85 @@
+#include "Display.h"
+
+#define DISPLAY_SHIFT_MASK ((1 << DISPLAY_DATA) | (1 << DISPLAY_CLOCK))
+
+uint8_t display_frame[DISPLAY_DIGITS];
+
+//Set when the frame differs from what is held in the chain
+static uint8_t display_dirty;
+
+void init_display(void)
+{
+    DISPLAY_DDR |= DISPLAY_SHIFT_MASK | (1 << DISPLAY_LATCH);
+    DISPLAY_PORT &= ~(DISPLAY_SHIFT_MASK | (1 << DISPLAY_LATCH));
+
+    //Chain content is unknown after reset
+    display_dirty = 1;
+}
+
+void display_set_digit(uint8_t digit, uint8_t segments)
+{
+    segments = DISPLAY_SEGMENT_MAP(digit, segments);
+
+    if(display_frame[digit] != segments)
+    {
+        display_frame[digit] = segments;
+        display_dirty = 1;
+    }
+}
+
+void display_clear(void)
+{
+    for(uint8_t i = 0; i < DISPLAY_DIGITS; ++i)
+        display_set_digit(i, 0x00);
+}
+
+void display_invalidate(void)
+{
+    display_dirty = 1;
+}
+
+//Shift one register worth of data
+//idle is the port value with data and clock LOW
+static inline void shift_byte(uint8_t data, uint8_t idle)
+{
+    for(uint8_t i = 0; i < 8; ++i)
+    {
+        //Clock LOW and data set in a single port write
+#if DISPLAY_LSB_FIRST
+        DISPLAY_PORT = (data & 0x01) ? (idle | (1 << DISPLAY_DATA)) : idle;
+        data >>= 1;
+#else
+        DISPLAY_PORT = (data & 0x80) ? (idle | (1 << DISPLAY_DATA)) : idle;
+        data <<= 1;
+#endif
+        //Toggle clock HIGH, 595 reads on LOW to HIGH
+        DISPLAY_PIN = (1 << DISPLAY_CLOCK);
+    }
+}
+
+uint8_t display_flush(void)
+{
+    //The chain only shifts as a whole, a register can not be skipped
+    //without moving every register behind it, so write all or nothing
+    if(!display_dirty)
+        return 0;
+
+    uint8_t idle = DISPLAY_PORT & ~DISPLAY_SHIFT_MASK;
+
+#if DISPLAY_CHAIN_REVERSED
+    for(uint8_t digit = DISPLAY_DIGITS; digit-- > 0;)
+        shift_byte(display_frame[digit], idle);
+#else
+    for(uint8_t digit = 0; digit < DISPLAY_DIGITS; ++digit)
+        shift_byte(display_frame[digit], idle);
+#endif
+
+    DISPLAY_PORT = idle;
+
+    //Latch on LOW to HIGH once the whole frame is in the chain
+    DISPLAY_PORT |= (1 << DISPLAY_LATCH);
+    DISPLAY_PORT &= ~(1 << DISPLAY_LATCH);
+
+    display_dirty = 0;
+    return 1;
+}
@@ -0,0 +1,77 @@
+/*
+ * File:   Display.h
+ * Author: TallDwarf
+ *
+ * Driver for a chain of 74HC595 shift registers, one per 7 segment digit
+ */
+
+#ifndef DISPLAY_H
+#define	DISPLAY_H
+
+#include <avr/io.h>
+#include "Board.h"
+
+//Number of digits/595s in the chain (4 = HH:MM, 6 = HH:MM:SS, 8 = date + time)
+#ifndef DISPLAY_DIGITS
+#define DISPLAY_DIGITS 4
+#endif
+
+//Pins come from the board table
+//Data, clock and latch must share a port so a bit can be
+//presented and clocked with whole port writes
+#if !BOARD_SAME_PORT(BOARD_DIGIT_DATA, BOARD_DIGIT_CLOCK) || !BOARD_SAME_PORT(BOARD_DIGIT_DATA, BOARD_DIGIT_LATCH)
+#error "Display data, clock and latch must be on one port"
+#endif
+
+#define DISPLAY_PORT BOARD_PORT(BOARD_DIGIT_DATA)
+#define DISPLAY_PIN BOARD_PIN(BOARD_DIGIT_DATA)
+#define DISPLAY_DDR BOARD_DDR(BOARD_DIGIT_DATA)
+#define DISPLAY_DATA BOARD_BIT(BOARD_DIGIT_DATA)
+#define DISPLAY_CLOCK BOARD_BIT(BOARD_DIGIT_CLOCK)
+#define DISPLAY_LATCH BOARD_BIT(BOARD_DIGIT_LATCH)
+
+//1 = bit 0 of a frame byte is shifted first
+//0 = bit 7 of a frame byte is shifted first
+#ifndef DISPLAY_LSB_FIRST
+#define DISPLAY_LSB_FIRST 1
+#endif
+
+//1 = the last digit is shifted first so it ends at the far end of the chain
+//0 = the first digit is shifted first
+#ifndef DISPLAY_CHAIN_REVERSED
+#define DISPLAY_CHAIN_REVERSED 1
+#endif
+
+//Segment bit used as decimal point on every digit
+#ifndef DISPLAY_DP_BIT
+#define DISPLAY_DP_BIT 0
+#endif
+
+//Per digit segment remap, applied when a digit is written into the frame.
+//Override for digits mounted upside down or wired with a different segment order
+#ifndef DISPLAY_SEGMENT_MAP
+#define DISPLAY_SEGMENT_MAP(digit, segments) (segments)
+#endif
+
+#define DISPLAY_DP (1 << DISPLAY_DP_BIT)
+
+//Frame buffer, index 0 is the leftmost digit
+extern uint8_t display_frame[DISPLAY_DIGITS];
+
+void init_display(void);
+
+//Write segments to a digit, marks the frame dirty only if it changed
+//The colon is the decimal point of the digit the board wires it to
+void display_set_digit(uint8_t digit, uint8_t segments);
+
+//Clear all digits
+void display_clear(void);
+
+//Shift the frame out and latch it if anything changed since the last flush
+//Returns TRUE if the chain was written
+uint8_t display_flush(void);
+
+//Force the next flush to write the chain
+void display_invalidate(void);
+
+#endif	/* DISPLAY_H */
@@ -0,0 +1,92 @@
+#include "Dst.h"
+#include "DstTable.h"
+#include "Rtc.h"
+
+//Month, date and hour packed so later in the year compares greater
+#define DST_KEY(month, date, hour) (((uint16_t)(month) << 10) | ((uint16_t)(date) << 5) | (hour))
+
+//Never matches a key
+#define DST_NONE 0xFFFF
+
+//The hour moves without the date, a transition must not cross midnight
+#if DST_START_HOUR > 22 || DST_END_HOUR < 1
+#error "DstTable.h transitions cross midnight, regenerate it with tools/gen_dst_table.py"
+#endif
+
+//Year 0 - 99 has an entry in dstDates
+#define DST_IN_TABLE(year) ((uint8_t)((year) - DST_FIRST_YEAR) < sizeof(dstDates))
+#define DST_BEFORE_TABLE(year) (!DST_IN_TABLE(year) && (year) < 100)
+
+static uint8_t dstActive = 0;
+static uint16_t dstNext = DST_NONE;
+
+static uint16_t start_key(uint8_t year)
+{
+    if(!DST_IN_TABLE(year))
+        return DST_NONE;
+    
+    return DST_KEY(DST_START_MONTH, DST_START_BASE + (pgm_read_byte(&dstDates[year - DST_FIRST_YEAR]) >> 4), DST_START_HOUR);
+}
+
+static uint16_t end_key(uint8_t year)
+{
+    if(!DST_IN_TABLE(year))
+        return DST_NONE;
+    
+    return DST_KEY(DST_END_MONTH, DST_END_BASE + (pgm_read_byte(&dstDates[year - DST_FIRST_YEAR]) & 0x0F), DST_END_HOUR);
+}
+
+static void store_dst(uint8_t active)
+{
+    dstActive = active;
+    queue_ram_rtc(DST_RAM_INDEX, active);
+}
+
+void dst_sync(uint8_t year, uint8_t month, uint8_t date, uint8_t hour)
+{
+    uint16_t now = DST_KEY(month, date, hour);
+    uint16_t start = start_key(year);
+    uint16_t end = end_key(year);
+    uint8_t stored;
+    
+    read_ram_rtc(DST_RAM_INDEX, &stored, 1);
+    
+    uint8_t active = (now >= start && now < end);
+    
+    //The hour before clocks go back happens twice
+    //trust the stored state if we already went back
+    if(now == end - 1 && stored == 0)
+        active = 0;
+    
+    if(active != stored)
+        store_dst(active);
+    else
+        dstActive = active;
+    
+    //Keys carry no year, dst_check holds the first start back until its year
+    if(active)
+        dstNext = end;
+    else if(DST_BEFORE_TABLE(year))
+        dstNext = start_key(DST_FIRST_YEAR);
+    else if(now < start)
+        dstNext = start;
+    else
+        dstNext = start_key(year + 1);
+}
+
+int8_t dst_check(uint8_t year, uint8_t month, uint8_t date, uint8_t hour, uint8_t minute)
+{
+    if(minute != 0 || DST_BEFORE_TABLE(year) || DST_KEY(month, date, hour) != dstNext)
+        return 0;
+    
+    if(dstActive)
+    {
+        store_dst(0);
+        dstNext = start_key(year + 1);
+        return -1;
+    }
+    
+    store_dst(1);
+    dstNext = end_key(year);
+    return 1;
+}
@@ -0,0 +1,30 @@
+/*
+ * File:   Dst.h
+ * Author: TallDwarf
+ *
+ * Automatic daylight saving using the transition dates in DstTable.h
+ * Regenerate the table with tools/gen_dst_table.py for another region
+ */
+
+#ifndef DST_H
+#define	DST_H
+
+#include <avr/io.h>
+
+//RTC RAM byte holding whether daylight saving is in effect
+#ifndef DST_RAM_INDEX
+#define DST_RAM_INDEX 0
+#endif
+
+//Both functions queue RTC writes, call commit_rtc afterwards
+
+//Work out if daylight saving is in effect and the next transition
+//Call after boot and whenever the time is changed
+//All values binary, year 0 - 99
+void dst_sync(uint8_t year, uint8_t month, uint8_t date, uint8_t hour);
+
+//Call once on every minute rollover
+//Returns the number of hours to move the clock by, 0 if no transition
+int8_t dst_check(uint8_t year, uint8_t month, uint8_t date, uint8_t hour, uint8_t minute);
+
+#endif	/* DST_H */
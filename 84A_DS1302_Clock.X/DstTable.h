@@ -0,0 +1,40 @@
+/*
+ * File:   DstTable.h
+ *
+ * Generated by tools/gen_dst_table.py - do not edit!
+ * Rule EU, UTC offset +0
+ */
+
+#ifndef DSTTABLE_H
+#define	DSTTABLE_H
+
+#include <avr/pgmspace.h>
+
+//Year 0 - 99 of the first table entry, earlier years have no daylight saving
+#define DST_FIRST_YEAR 0
+
+//Local standard time hour clocks go forward
+#define DST_START_MONTH 3
+#define DST_START_HOUR 1
+#define DST_START_BASE 25
+
+//Local daylight time hour clocks go back
+#define DST_END_MONTH 10
+#define DST_END_HOUR 2
+#define DST_END_BASE 25
+
+const uint8_t dstDates[100 - DST_FIRST_YEAR] PROGMEM =
+{
+    0x14, 0x03, 0x62, 0x51, 0x36, 0x25, 0x14, 0x03, 0x51, 0x40,
+    0x36, 0x25, 0x03, 0x62, 0x51, 0x40, 0x25, 0x14, 0x03, 0x62,
+    0x40, 0x36, 0x25, 0x14, 0x62, 0x51, 0x40, 0x36, 0x14, 0x03,
+    0x62, 0x51, 0x36, 0x25, 0x14, 0x03, 0x51, 0x40, 0x36, 0x25,
+    0x03, 0x62, 0x51, 0x40, 0x25, 0x14, 0x03, 0x62, 0x40, 0x36,
+    0x25, 0x14, 0x62, 0x51, 0x40, 0x36, 0x14, 0x03, 0x62, 0x51,
+    0x36, 0x25, 0x14, 0x03, 0x51, 0x40, 0x36, 0x25, 0x03, 0x62,
+    0x51, 0x40, 0x25, 0x14, 0x03, 0x62, 0x40, 0x36, 0x25, 0x14,
+    0x62, 0x51, 0x40, 0x36, 0x14, 0x03, 0x62, 0x51, 0x36, 0x25,
+    0x14, 0x03, 0x51, 0x40, 0x36, 0x25, 0x03, 0x62, 0x51, 0x40
+};
+
+#endif	/* DSTTABLE_H */
@@ -0,0 +1,27 @@
+#include "EventLog.h"
+
+static uint8_t eventHead = 0;
+
+void init_event_log(void)
+{
+    read_ram_rtc(EVENTLOG_RAM_HEAD, &eventHead, 1);
+    
+    //Fresh or corrupt RAM, start over at the first record
+    if(eventHead >= EVENTLOG_RECORDS)
+        eventHead = 0;
+}
+
+void log_event(uint8_t code, uint16_t minuteOfWeek)
+{
+    uint8_t index = EVENTLOG_RAM_START + eventHead * EVENTLOG_RECORD_SIZE;
+    uint16_t record = ((uint16_t)code << EVENTLOG_CODE_SHIFT) | (minuteOfWeek & EVENTLOG_MINUTE_MASK);
+    
+    //Wrap stays inside the record area
+    if(++eventHead == EVENTLOG_RECORDS)
+        eventHead = 0;
+    
+    //Several events before a commit share one head write
+    queue_ram_deferred_rtc(index, record >> 8);
+    queue_ram_deferred_rtc(index + 1, record & 0xFF);
+    queue_ram_deferred_rtc(EVENTLOG_RAM_HEAD, eventHead);
+}
@@ -0,0 +1,56 @@
+/*
+ * File:   EventLog.h
+ * Author: TallDwarf
+ *
+ * Ring buffer of time stamped events kept in battery backed RTC RAM
+ *
+ * RAM map
+ *  0 - 6   settings (DST_RAM_INDEX, WATCHDOG_RAM_INDEX, CLOCK_RAM_INDEX in
+ *          main.c), never touched by the log
+ *  7       head, index of the next record to be written
+ *  8 - 29  records, 2 bytes each, high byte first
+ *
+ * Record: event code in bits 15 - 14, minute of week in bits 13 - 0
+ */
+
+#ifndef EVENTLOG_H
+#define	EVENTLOG_H
+
+#include <avr/io.h>
+#include "Rtc.h"
+
+//First RAM byte owned by the log, everything below is settings
+#ifndef EVENTLOG_RAM_HEAD
+#define EVENTLOG_RAM_HEAD 7
+#endif
+
+#ifndef EVENTLOG_RECORDS
+#define EVENTLOG_RECORDS 11
+#endif
+
+#define EVENTLOG_RAM_START (EVENTLOG_RAM_HEAD + 1)
+#define EVENTLOG_RECORD_SIZE 2
+
+#if EVENTLOG_RAM_START + EVENTLOG_RECORDS * EVENTLOG_RECORD_SIZE > RTC_RAM_SIZE
+#error "Event log does not fit in RTC RAM"
+#endif
+
+#define EVENTLOG_CODE_SHIFT 14
+#define EVENTLOG_MINUTE_MASK 0x3FFF
+
+//Event codes, 2 bits
+#define EVENT_BOOT 0
+#define EVENT_POWER_LOST 1
+#define EVENT_TIME_EDITED 2
+#define EVENT_SYNC_SKIPPED 3
+
+//Read the head back from RAM, call after init_rtc and after RAM was
+//written from outside
+void init_event_log(void);
+
+//Queue a record and the new head as deferred writes, they go out with
+//the next commit that writes something else, so an event adds no write
+//protect cycle of its own. Call flush_rtc where a record must not wait
+void log_event(uint8_t code, uint16_t minuteOfWeek);
+
+#endif	/* EVENTLOG_H */
@@ -0,0 +1,69 @@
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "Power.h"
+
+static uint8_t convert(void)
+{
+    ADCSRA |= (1 << ADSC);
+    loop_until_bit_is_clear(ADCSRA, ADSC);
+    
+    return ADCH;
+}
+
+uint8_t power_read_supply(void)
+{
+    uint8_t admux = ADMUX;
+    ADMUX = POWER_BANDGAP_MUX;
+    
+    //Bandgap needs to settle after switching, throw away first result
+    convert();
+    uint8_t supply = convert();
+    
+    ADMUX = admux;
+    
+    return supply;
+}
+
+uint8_t power_is_low(void)
+{
+    return power_read_supply() > POWER_MV_TO_ADC(POWER_LOW_MV);
+}
+
+//Only here to wake from power down
+EMPTY_INTERRUPT(WDT_vect);
+
+void power_down_until_restored(void)
+{
+    //Only the watchdog may wake us
+    uint8_t gimsk = GIMSK;
+    GIMSK = 0;
+    
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    
+    do
+    {
+        ADCSRA &= ~(1 << ADEN);
+        
+        //Watchdog interrupt mode, 1 second
+        cli();
+        WDTCSR |= (1 << WDCE) | (1 << WDE);
+        WDTCSR = (1 << WDIE) | (1 << WDP2) | (1 << WDP1);
+        
+        sleep_enable();
+        sleep_bod_disable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+        
+        ADCSRA |= (1 << ADEN);
+    }
+    while(power_read_supply() > POWER_MV_TO_ADC(POWER_RESTORE_MV));
+    
+    //Watchdog off
+    cli();
+    WDTCSR |= (1 << WDCE) | (1 << WDE);
+    WDTCSR = 0x00;
+    
+    GIMSK = gimsk;
+    sei();
+}
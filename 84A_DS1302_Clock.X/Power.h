@@ -0,0 +1,44 @@
+/*
+ * File:   Power.h
+ * Author: TallDwarf
+ *
+ * Supply monitor using the internal 1.1V bandgap measured against VCC
+ * and a watchdog woken power down mode for running from backup
+ *
+ * Datasheet estimate, not measured: power down with the watchdog running
+ * is ~4uA at 3V, waking once a second for ~1ms at ~1mA to measure the
+ * supply adds ~1uA on average
+ */
+
+#ifndef POWER_H
+#define	POWER_H
+
+#include <avr/io.h>
+
+//Supply drops below this, stop everything and sleep
+#ifndef POWER_LOW_MV
+#define POWER_LOW_MV 4300
+#endif
+
+//Supply back above this, wake up, higher than low for hysteresis
+#ifndef POWER_RESTORE_MV
+#define POWER_RESTORE_MV 4600
+#endif
+
+//8 bit ADC result of the bandgap at a supply voltage, rises as VCC falls
+#define POWER_MV_TO_ADC(mv) ((uint8_t)((1100UL * 256) / (mv)))
+
+//MUX5:0 = 100001 selects the bandgap, REFS = 00 uses VCC as reference
+#define POWER_BANDGAP_MUX ((1 << MUX5) | (1 << MUX0))
+
+//Raw bandgap reading, restores the ADC channel afterwards
+//ADC must be idle and enabled
+uint8_t power_read_supply(void);
+
+uint8_t power_is_low(void);
+
+//Sleep in power down, waking on the watchdog to check the supply
+//Returns once the supply has been restored
+void power_down_until_restored(void);
+
+#endif	/* POWER_H */
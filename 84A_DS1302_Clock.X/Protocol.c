@@ -0,0 +1,170 @@
+#include <util/crc16.h>
+#include "Protocol.h"
+#include "Serial.h"
+#include "Rtc.h"
+#include "Alarm.h"
+
+//Offsets into a request frame
+#define FRAME_COMMAND 1
+#define FRAME_ARGUMENT 2
+#define FRAME_LENGTH 3
+#define FRAME_DATA 4
+
+//Header plus CRC
+#define FRAME_OVERHEAD 5
+
+static uint8_t response[RTC_RAM_SIZE];
+
+static void send_response(uint8_t status, uint8_t length)
+{
+    uint8_t crc = _crc8_ccitt_update(0, status);
+    crc = _crc8_ccitt_update(crc, length);
+    
+    serial_write_byte(PROTOCOL_SYNC_RESPONSE);
+    serial_write_byte(status);
+    serial_write_byte(length);
+    
+    for(uint8_t i = 0; i < length; ++i)
+    {
+        crc = _crc8_ccitt_update(crc, response[i]);
+        serial_write_byte(response[i]);
+    }
+    
+    serial_write_byte(crc);
+}
+
+//Returns status, fills response and its length
+static uint8_t handle_frame(uint8_t* frame, uint8_t* length, uint8_t* changed)
+{
+    uint8_t argument = frame[FRAME_ARGUMENT];
+    uint8_t dataLength = frame[FRAME_LENGTH];
+    uint8_t* data = &frame[FRAME_DATA];
+    
+    *length = 0;
+    
+    switch(frame[FRAME_COMMAND])
+    {
+        case PROTOCOL_CLOCK_READ:
+            read_time_rtc(response);
+            *length = 8;
+            break;
+            
+        case PROTOCOL_CLOCK_WRITE:
+            //A clock out of range would be refused at the next boot
+            if(dataLength != 8 || !is_valid_clock_rtc(data))
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            queue_time_rtc(data);
+            commit_rtc();
+            *changed = PROTOCOL_CHANGED_CLOCK;
+            break;
+            
+        case PROTOCOL_REGISTER_READ:
+            read_register_rtc(argument, response);
+            *length = 1;
+            break;
+            
+        case PROTOCOL_REGISTER_WRITE:
+            if(dataLength != 1)
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            queue_register_rtc(argument, data[0]);
+            commit_rtc();
+            
+            //DS1302 RAM is addressed as registers too
+            *changed = PROTOCOL_CHANGED_CLOCK | PROTOCOL_CHANGED_RAM;
+            break;
+            
+        case PROTOCOL_RAM_READ:
+            if(dataLength != 1 || argument + data[0] > RTC_RAM_SIZE)
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            *length = data[0];
+            read_ram_rtc(argument, response, *length);
+            break;
+            
+        case PROTOCOL_RAM_WRITE:
+            if(argument + dataLength > RTC_RAM_SIZE)
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            write_ram_rtc(argument, data, dataLength);
+            *changed = PROTOCOL_CHANGED_RAM;
+            break;
+            
+        case PROTOCOL_ALARM_READ:
+            if(argument >= ALARM_COUNT)
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            alarm_get(argument, (Alarm*)response);
+            *length = sizeof(Alarm);
+            break;
+            
+        case PROTOCOL_ALARM_WRITE:
+            if(argument >= ALARM_COUNT || dataLength != sizeof(Alarm))
+                return PROTOCOL_ERROR_ARGUMENT;
+            
+            alarm_set(argument, (Alarm*)data);
+            *changed = PROTOCOL_CHANGED_ALARMS;
+            break;
+            
+        default:
+            return PROTOCOL_ERROR_COMMAND;
+    }
+    
+    return PROTOCOL_OK;
+}
+
+uint8_t protocol_poll(void)
+{
+    uint8_t count = serialCount;
+    
+    if(count == 0)
+        return 0;
+    
+    //Resync on anything that is not the start of a frame
+    if(serialFrame[0] != PROTOCOL_SYNC_REQUEST)
+    {
+        serial_reset();
+        return 0;
+    }
+    
+    if(count < FRAME_DATA)
+        return 0;
+    
+    uint8_t total = serialFrame[FRAME_LENGTH] + FRAME_OVERHEAD;
+    
+    if(total > SERIAL_FRAME_MAX)
+    {
+        serial_reset();
+        send_response(PROTOCOL_ERROR_ARGUMENT, 0);
+        return 0;
+    }
+    
+    if(count < total)
+        return 0;
+    
+    //Frame complete, later bytes are appended after it
+    uint8_t* frame = (uint8_t*)serialFrame;
+    uint8_t crc = 0;
+    uint8_t length = 0;
+    uint8_t changed = 0;
+    uint8_t status;
+    
+    for(uint8_t i = FRAME_COMMAND; i < total; ++i)
+        crc = _crc8_ccitt_update(crc, frame[i]);
+    
+    //Log records still waiting for a commit go out before the host
+    //reads or overwrites RTC RAM
+    flush_rtc();
+    
+    //CRC over the data plus its own CRC byte leaves 0
+    if(crc != 0)
+        status = PROTOCOL_ERROR_CRC;
+    else
+        status = handle_frame(frame, &length, &changed);
+    
+    serial_reset();
+    send_response(status, length);
+    
+    return changed;
+}
@@ -0,0 +1,53 @@
+/*
+ * File:   Protocol.h
+ * Author: TallDwarf
+ *
+ * Framed configuration protocol over the serial port
+ *
+ * Request:  SYNC_REQUEST command argument length data[length] crc
+ * Response: SYNC_RESPONSE status length data[length] crc
+ * CRC is CRC-8 (poly 0x07, init 0x00) over everything after the sync byte
+ */
+
+#ifndef PROTOCOL_H
+#define	PROTOCOL_H
+
+#include <avr/io.h>
+
+#define PROTOCOL_SYNC_REQUEST 0xA5
+#define PROTOCOL_SYNC_RESPONSE 0x5A
+
+//Read all 8 clock registers as one burst
+#define PROTOCOL_CLOCK_READ 0x01
+//Write all 8 clock registers as one burst, length 8
+//A clock register out of range is refused with PROTOCOL_ERROR_ARGUMENT
+#define PROTOCOL_CLOCK_WRITE 0x02
+//Read a single register, argument = register address of the fitted RTC
+//(DS1302 write address or DS1307 register number)
+#define PROTOCOL_REGISTER_READ 0x03
+//Write a single register, argument as for read, length 1
+#define PROTOCOL_REGISTER_WRITE 0x04
+//Read RAM, argument = first byte, data[0] = count
+#define PROTOCOL_RAM_READ 0x05
+//Write RAM, argument = first byte, length = count
+#define PROTOCOL_RAM_WRITE 0x06
+//Read alarm, argument = alarm index
+#define PROTOCOL_ALARM_READ 0x07
+//Write alarm, argument = alarm index, data = days, hour, minute
+#define PROTOCOL_ALARM_WRITE 0x08
+
+#define PROTOCOL_OK 0x00
+#define PROTOCOL_ERROR_CRC 0x01
+#define PROTOCOL_ERROR_COMMAND 0x02
+#define PROTOCOL_ERROR_ARGUMENT 0x03
+
+//What a frame changed, so the caller can reload what it caches
+#define PROTOCOL_CHANGED_CLOCK (1 << 0)
+#define PROTOCOL_CHANGED_RAM (1 << 1)
+#define PROTOCOL_CHANGED_ALARMS (1 << 2)
+
+//Handle a complete frame if one has arrived
+//Returns the PROTOCOL_CHANGED_ flags of what it wrote, 0 if nothing
+uint8_t protocol_poll(void);
+
+#endif	/* PROTOCOL_H */
@@ -0,0 +1,107 @@
+/*
+ * File:   Rtc.h
+ * Author: TallDwarf
+ *
+ * RTC interface, bound at compile time to the backend for the chip in
+ * Board.h. Every name maps straight onto the driver so nothing is
+ * added to a call. All backends read and write the DS1302 register
+ * image and number RAM bytes from 0
+ */
+
+#ifndef RTC_H
+#define	RTC_H
+
+#include <avr/io.h>
+#include "Board.h"
+
+#if RTC_BACKEND == RTC_DS1302
+
+#include "DS1302.h"
+
+#define RTC_RAM_SIZE DS1302_RAM_SIZE
+
+//Read the clock into the register image, FALSE if it has to be written
+#define init_rtc(time) init_ds1302(time)
+
+//Every clock register in the image a valid BCD value
+#define is_valid_clock_rtc(time) is_valid_clock_ds1302(time)
+
+//Bus pins for running from the supply, released while on backup
+#define init_rtc_pins() init_ds1302_pins()
+#define release_rtc_pins() release_ds1302_pins()
+
+//Clock into the first 8 bytes of the image in one transaction
+#define read_time_rtc(time) burst_read_from_ds1302(time)
+
+//Seconds register alone, clock halt in bit 7
+#define read_seconds_rtc(data) read_from_address_ds1302(DS1302_SECOND, data)
+
+//Chip register by its datasheet address, for the serial protocol
+#define read_register_rtc(address, data) read_from_address_ds1302(address, data)
+#define queue_register_rtc(address, data) queue_write_ds1302((address) & ~(1 << DS1302_READBIT), data)
+
+#define queue_time_rtc(time) queue_clock_ds1302(time)
+
+//Hour register alone from its image byte
+#define queue_hour_rtc(hour) queue_write_ds1302(DS1302_HOUR, hour)
+
+//Stop the oscillator, time is kept but stops counting
+#define queue_halt_rtc() queue_write_ds1302(DS1302_SECOND, 0x80)
+
+#define queue_ram_rtc(index, data) queue_write_ds1302(DS1302_RAM(index), data)
+#define read_ram_rtc(index, data, count) read_ram_ds1302(index, data, count)
+#define write_ram_rtc(index, data, count) write_ram_ds1302(index, data, count)
+
+//RAM write that goes out with the next commit that happens anyway
+#define queue_ram_deferred_rtc(index, data) queue_deferred_ds1302(DS1302_RAM(index), data)
+
+#define commit_rtc() commit_ds1302()
+
+//Commit deferred writes too
+#define flush_rtc() flush_ds1302()
+
+//Backup charger from the image trickle charge byte
+#define set_backup_rtc(setting) set_trickle_charge_ds1302(setting)
+
+#elif RTC_BACKEND == RTC_DS1307
+
+#include "DS1307.h"
+
+#define RTC_RAM_SIZE DS1307_RAM_SIZE
+
+#define init_rtc(time) init_ds1307(time)
+#define is_valid_clock_rtc(time) is_valid_clock_ds1302(time)
+
+#define init_rtc_pins() init_usi_twi()
+#define release_rtc_pins() release_usi_twi()
+
+#define read_time_rtc(time) read_time_ds1307(time)
+#define read_seconds_rtc(data) read_from_address_ds1307(DS1307_SECOND, data)
+
+#define read_register_rtc(address, data) read_from_address_ds1307(address, data)
+#define queue_register_rtc(address, data) queue_write_ds1307(address, data)
+
+#define queue_time_rtc(time) queue_clock_ds1307(time)
+#define queue_hour_rtc(hour) queue_write_ds1307(DS1307_HOUR, DS1307_HOUR_FROM_IMAGE(hour))
+#define queue_halt_rtc() queue_write_ds1307(DS1307_SECOND, 0x80)
+
+#define queue_ram_rtc(index, data) queue_write_ds1307(DS1307_RAM(index), data)
+#define read_ram_rtc(index, data, count) read_ram_ds1307(index, data, count)
+#define write_ram_rtc(index, data, count) write_ram_ds1307(index, data, count)
+#define queue_ram_deferred_rtc(index, data) queue_deferred_ds1307(DS1307_RAM(index), data)
+
+#define commit_rtc() commit_ds1307()
+#define flush_rtc() flush_ds1307()
+
+//No charger, the backup is a primary cell
+static inline uint8_t set_backup_rtc(uint8_t setting)
+{
+    (void)setting;
+    return 1;
+}
+
+#else
+#error "Unknown RTC_BACKEND"
+#endif
+
+#endif	/* RTC_H */
@@ -0,0 +1,102 @@
+#include <avr/interrupt.h>
+#include "Serial.h"
+
+volatile uint8_t serialFrame[SERIAL_FRAME_MAX];
+volatile uint8_t serialCount = 0;
+
+void init_serial(void)
+{
+    //RX as input with pull up, TX idles HIGH
+    SERIAL_RX_DDR &= ~(1 << SERIAL_RX);
+    SERIAL_RX_PORT |= (1 << SERIAL_RX);
+    
+    SERIAL_TX_PORT |= (1 << SERIAL_TX);
+    SERIAL_TX_DDR |= (1 << SERIAL_TX);
+    
+    //Start bit falling edge wakes the receiver
+    SERIAL_RX_PCMSK |= (1 << SERIAL_RX_PCINT);
+    GIMSK |= (1 << SERIAL_RX_PCIE);
+}
+
+void serial_reset(void)
+{
+    serialCount = 0;
+}
+
+//Spin until Timer 0 reaches target, interrupts that come in meanwhile
+//only move the edge, the next target is still counted from the start bit
+static inline void wait_counts(uint8_t target)
+{
+    while((int8_t)(TCNT0 - target) < 0);
+}
+
+void serial_write_byte(uint8_t data)
+{
+    uint8_t target = TCNT0;
+    
+    //Start bit
+    SERIAL_TX_PORT &= ~(1 << SERIAL_TX);
+    target += SERIAL_BIT_COUNTS;
+    wait_counts(target);
+    
+    for(uint8_t i = 0; i < 8; ++i)
+    {
+        if(data & 0x01)
+            SERIAL_TX_PORT |= (1 << SERIAL_TX);
+        else
+            SERIAL_TX_PORT &= ~(1 << SERIAL_TX);
+        
+        data >>= 1;
+        target += SERIAL_BIT_COUNTS;
+        wait_counts(target);
+    }
+    
+    //Stop bit
+    SERIAL_TX_PORT |= (1 << SERIAL_TX);
+    target += SERIAL_BIT_COUNTS;
+    wait_counts(target);
+}
+
+//Receive a whole byte from the start bit edge
+//The pin change group is off for the byte so the timer interrupts can run
+ISR(SERIAL_RX_vect)
+{
+    uint8_t target = TCNT0;
+    
+    //Rising edges and idle line are not start bits
+    if(bit_is_set(SERIAL_RX_PIN, SERIAL_RX))
+        return;
+    
+    uint8_t data = 0;
+    
+    GIMSK &= ~(1 << SERIAL_RX_PCIE);
+    sei();
+    
+    //Sample in the middle of each bit
+    target += SERIAL_BIT_COUNTS / 2;
+    wait_counts(target);
+    
+    for(uint8_t i = 0; i < 8; ++i)
+    {
+        target += SERIAL_BIT_COUNTS;
+        wait_counts(target);
+        
+        data >>= 1;
+        
+        if(bit_is_set(SERIAL_RX_PIN, SERIAL_RX))
+            data |= 0x80;
+    }
+    
+    //Into the stop bit so its edge is not taken for a start bit
+    target += SERIAL_BIT_COUNTS;
+    wait_counts(target);
+    
+    cli();
+    
+    //Edges inside the byte must not start another one
+    GIFR = (1 << SERIAL_RX_PCIF);
+    GIMSK |= (1 << SERIAL_RX_PCIE);
+    
+    if(serialCount < SERIAL_FRAME_MAX)
+        serialFrame[serialCount++] = data;
+}
@@ -0,0 +1,109 @@
+/*
+ * File:   Serial.h
+ * Author: TallDwarf
+ *
+ * Bit banged 8N1 UART
+ * Bytes are received in a pin change interrupt into a frame buffer,
+ * sending blocks for the length of each byte. Both time their bits off
+ * Timer 0 and leave other interrupts running between bits
+ */
+
+#ifndef SERIAL_H
+#define	SERIAL_H
+
+#include <avr/io.h>
+#include "Board.h"
+
+#ifndef F_CPU
+#define F_CPU 8000000UL
+#endif
+
+#ifndef SERIAL_BAUD
+#define SERIAL_BAUD 9600
+#endif
+
+//Defaults share the left/right button lines (USI DO/DI)
+//With an I2C RTC on the USI the right button and receive move to PB0
+#if RTC_BACKEND != RTC_DS1302 && !defined(SERIAL_RX)
+#define SERIAL_RX PINB0
+#define SERIAL_RX_PIN PINB
+#define SERIAL_RX_PORT PORTB
+#define SERIAL_RX_DDR DDRB
+#define SERIAL_RX_PCMSK PCMSK1
+#define SERIAL_RX_PCINT PCINT8
+#define SERIAL_RX_PCIE PCIE1
+#define SERIAL_RX_PCIF PCIF1
+#define SERIAL_RX_vect PCINT1_vect
+#endif
+
+#ifndef SERIAL_RX
+#define SERIAL_RX PINA6
+#endif
+
+#ifndef SERIAL_RX_PIN
+#define SERIAL_RX_PIN PINA
+#endif
+
+#ifndef SERIAL_RX_PORT
+#define SERIAL_RX_PORT PORTA
+#endif
+
+#ifndef SERIAL_RX_DDR
+#define SERIAL_RX_DDR DDRA
+#endif
+
+#ifndef SERIAL_RX_PCMSK
+#define SERIAL_RX_PCMSK PCMSK0
+#endif
+
+#ifndef SERIAL_RX_PCINT
+#define SERIAL_RX_PCINT PCINT6
+#endif
+
+#ifndef SERIAL_RX_PCIE
+#define SERIAL_RX_PCIE PCIE0
+#endif
+
+#ifndef SERIAL_RX_PCIF
+#define SERIAL_RX_PCIF PCIF0
+#endif
+
+#ifndef SERIAL_RX_vect
+#define SERIAL_RX_vect PCINT0_vect
+#endif
+
+#ifndef SERIAL_TX
+#define SERIAL_TX PORTA5
+#endif
+
+#ifndef SERIAL_TX_PORT
+#define SERIAL_TX_PORT PORTA
+#endif
+
+#ifndef SERIAL_TX_DDR
+#define SERIAL_TX_DDR DDRA
+#endif
+
+//Timer 0 counts at F_CPU / 8, init_pwm sets it running before the port
+//Waits compare the counter as signed 8 bit so a bit must fit in 127 counts
+#define SERIAL_TIMER_PRESCALE 8
+#define SERIAL_BIT_COUNTS ((uint8_t)(F_CPU / SERIAL_TIMER_PRESCALE / SERIAL_BAUD))
+
+#if F_CPU / SERIAL_TIMER_PRESCALE / SERIAL_BAUD > 127
+#error "SERIAL_BAUD too low to time off Timer 0"
+#endif
+
+//Largest frame, sync + command + argument + length + 31 RAM bytes + CRC
+#define SERIAL_FRAME_MAX 36
+
+extern volatile uint8_t serialFrame[SERIAL_FRAME_MAX];
+extern volatile uint8_t serialCount;
+
+void init_serial(void);
+
+void serial_write_byte(uint8_t data);
+
+//Drop any partly received frame
+void serial_reset(void);
+
+#endif	/* SERIAL_H */
@@ -0,0 +1,83 @@
+/*
+ * File:   SimTrace.c
+ * Author: TallDwarf
+ *
+ * simavr setup for tracing the RTC and 595 buses, only built in
+ * when SIM_TRACE is defined. simavr reads these entries out of the
+ * .mmcu section of the elf and records the pins to a VCD file
+ *
+ * Build with -DSIM_TRACE -I<simavr>/include/simavr/avr and link with
+ * -Wl,--undefined=_mmcu,--section-start=.mmcu=0x910000 then run
+ *     simavr 84A_DS1302_Clock.X.elf
+ * and decode the result with tools/decode_trace.py
+ *
+ * With BENCH defined as well the Bench.h markers are traced for cycle counts
+ *
+ * No RTC is modelled, the firmware always takes the cold boot path and
+ * never locks the phase, see MEASUREMENTS.md
+ */
+
+#ifdef SIM_TRACE
+
+#include <avr_mcu_section.h>
+#include "Board.h"
+#include "Serial.h"
+
+#ifndef SIM_TRACE_FILE
+#define SIM_TRACE_FILE "bus_trace.vcd"
+#endif
+
+//Port letter as simavr expects it
+#define SIM_PORT(pin) ((BOARD_ID(pin) == BOARD_PORT_ID_A) ? 'A' : 'B')
+
+//Same as AVR_MCU_VCD_PORT_PIN, which can not take the pin table
+#define SIM_TRACE_PIN(pin, label) \
+    const struct avr_mmcu_vcd_trace_t simTrace_ ## label _MMCU_ = \
+    { \
+        .tag = AVR_MMCU_TAG_VCD_PORTPIN, \
+        .len = sizeof(struct avr_mmcu_vcd_trace_t) - 2, \
+        .mask = SIM_PORT(pin), \
+        .what = (void*)BOARD_BIT(pin), \
+        .name = #label, \
+    }
+
+#define SIM_BUTTONS(port) \
+    (BOARD_MASK_ON(BOARD_LEFT_BUTTON, port) | BOARD_MASK_ON(BOARD_CENTER_BUTTON, port) | \
+    BOARD_MASK_ON(BOARD_RIGHT_BUTTON, port))
+
+AVR_MCU(F_CPU, "attiny84");
+
+//Supply above POWER_LOW_MV so the clock does not power down
+AVR_MCU_VOLTAGES(5000, 5000, 0);
+
+//Buttons are released, held LOW the serial jig check waits forever
+AVR_MCU_EXTERNAL_PORT_PULL('A', SIM_BUTTONS(A), SIM_BUTTONS(A));
+AVR_MCU_EXTERNAL_PORT_PULL('B', SIM_BUTTONS(B), SIM_BUTTONS(B));
+
+//Pins are logged on change, the period is how often the file is flushed in us
+AVR_MCU_VCD_FILE(SIM_TRACE_FILE, 1000);
+
+#if RTC_BACKEND == RTC_DS1302
+SIM_TRACE_PIN(BOARD_TIME_CE, TIME_CE);
+SIM_TRACE_PIN(BOARD_TIME_CLOCK, TIME_CLOCK);
+SIM_TRACE_PIN(BOARD_TIME_DATA, TIME_DATA);
+#else
+//Logged for viewing, tools/decode_trace.py only decodes the DS1302 bus
+SIM_TRACE_PIN(BOARD_TIME_SCL, TIME_SCL);
+SIM_TRACE_PIN(BOARD_TIME_SDA, TIME_SDA);
+#endif
+SIM_TRACE_PIN(BOARD_DIGIT_DATA, DIGIT_DATA);
+SIM_TRACE_PIN(BOARD_DIGIT_CLOCK, DIGIT_CLOCK);
+SIM_TRACE_PIN(BOARD_DIGIT_LATCH, DIGIT_LATCH);
+SIM_TRACE_PIN(BOARD_DIGIT_CLEAR, DIGIT_CLEAR);
+SIM_TRACE_PIN(BOARD_DIGIT_OUTPUT, DIGIT_OUTPUT);
+
+#ifdef BENCH
+//Bench.h markers, every write is logged at its cycle
+const struct avr_mmcu_vcd_trace_t simTraceBench[] _MMCU_ =
+{
+    { AVR_MCU_VCD_SYMBOL("BENCH"), .what = (void*)&GPIOR0, },
+};
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+#include <avr/eeprom.h>
+#include "TempComp.h"
+
+//Stored with the top bit flipped so erased EEPROM reads as unknown
+#define TEMPCOMP_STORE(value) ((uint16_t)(value) ^ 0x8000)
+
+uint16_t EEMEM tempcompStore[TEMPCOMP_BUCKETS];
+
+static int16_t tempcompTable[TEMPCOMP_BUCKETS];
+
+void init_tempcomp(void)
+{
+    for(uint8_t i = 0; i < TEMPCOMP_BUCKETS; ++i)
+        tempcompTable[i] = TEMPCOMP_STORE(eeprom_read_word(&tempcompStore[i]));
+}
+
+static uint8_t convert(void)
+{
+    ADCSRA |= (1 << ADSC);
+    loop_until_bit_is_clear(ADCSRA, ADSC);
+    
+    return ADCH;
+}
+
+uint8_t tempcomp_read(void)
+{
+    uint8_t admux = ADMUX;
+    ADMUX = TEMPCOMP_MUX;
+    
+    //Reference and channel both change, let them settle first
+    convert();
+    convert();
+    uint8_t temperature = convert();
+    
+    ADMUX = admux;
+    
+    return temperature;
+}
+
+uint8_t tempcomp_bucket(uint8_t temperature)
+{
+    if(temperature < TEMPCOMP_FIRST)
+        return 0;
+    
+    temperature = (temperature - TEMPCOMP_FIRST) >> TEMPCOMP_SHIFT;
+    
+    return (temperature < TEMPCOMP_BUCKETS) ? temperature : TEMPCOMP_BUCKETS - 1;
+}
+
+int16_t tempcomp_offset(uint8_t temperature)
+{
+    return tempcompTable[tempcomp_bucket(temperature)];
+}
+
+void tempcomp_learn(uint8_t temperature, int16_t offset)
+{
+    uint8_t bucket = tempcomp_bucket(temperature);
+    int16_t learned = tempcompTable[bucket];
+    
+    if(learned == TEMPCOMP_UNKNOWN)
+        learned = offset;
+    else
+        learned += ((int32_t)offset - learned) >> TEMPCOMP_LEARN_SHIFT;
+    
+    tempcompTable[bucket] = learned;
+    
+    //Measurements jitter by a fraction of a count, keep EEPROM writes rare
+    int16_t stored = TEMPCOMP_STORE(eeprom_read_word(&tempcompStore[bucket]));
+    
+    if(stored != TEMPCOMP_UNKNOWN)
+    {
+        //int is 16 bits on the target, learned - stored can overflow it
+        int32_t moved = (int32_t)learned - stored;
+        
+        if(moved < TEMPCOMP_SAVE_DELTA && moved > -TEMPCOMP_SAVE_DELTA)
+            return;
+    }
+    
+    eeprom_update_word(&tempcompStore[bucket], TEMPCOMP_STORE(learned));
+}
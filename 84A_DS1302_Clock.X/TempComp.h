@@ -0,0 +1,57 @@
+/*
+ * File:   TempComp.h
+ * Author: TallDwarf
+ *
+ * Learns how the Timer 1 tick period moves with chip temperature so the
+ * tick can be corrected without watching the RTC
+ *
+ * Periods are kept per temperature bucket as an offset from the nominal
+ * half second in 1/16 Timer 1 counts and persisted in EEPROM
+ */
+
+#ifndef TEMPCOMP_H
+#define	TEMPCOMP_H
+
+#include <avr/io.h>
+
+//MUX5:0 = 100010 selects the sensor, REFS = 10 uses the internal 1.1V
+#define TEMPCOMP_MUX ((1 << REFS1) | (1 << MUX5) | (1 << MUX1))
+
+//8 bit sensor readings are ~4C apart, ~57 at -40C and ~92 at 85C
+//Each bucket covers 1 << TEMPCOMP_SHIFT readings from TEMPCOMP_FIRST
+#ifndef TEMPCOMP_FIRST
+#define TEMPCOMP_FIRST 57
+#endif
+
+#ifndef TEMPCOMP_SHIFT
+#define TEMPCOMP_SHIFT 1
+#endif
+
+#ifndef TEMPCOMP_BUCKETS
+#define TEMPCOMP_BUCKETS 18
+#endif
+
+//New measurements move a bucket by 1 / (1 << TEMPCOMP_LEARN_SHIFT)
+#define TEMPCOMP_LEARN_SHIFT 2
+
+//A bucket is only written back once it moved by a whole count
+#define TEMPCOMP_SAVE_DELTA 16
+
+#define TEMPCOMP_UNKNOWN 0x7FFF
+
+//Load the learned periods from EEPROM
+void init_tempcomp(void);
+
+//Raw 8 bit sensor reading, restores the ADC channel afterwards
+//ADC must be idle and enabled
+uint8_t tempcomp_read(void);
+
+uint8_t tempcomp_bucket(uint8_t temperature);
+
+//Learned period offset at a temperature, TEMPCOMP_UNKNOWN if none yet
+int16_t tempcomp_offset(uint8_t temperature);
+
+//Fold a measured period offset into the bucket for a temperature
+void tempcomp_learn(uint8_t temperature, int16_t offset);
+
+#endif	/* TEMPCOMP_H */
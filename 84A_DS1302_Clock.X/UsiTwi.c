@@ -0,0 +1,128 @@
+#include "Board.h"
+
+//Only boards with an I2C RTC have the pins
+#if RTC_BACKEND != RTC_DS1302
+
+#include <util/delay.h>
+#include "UsiTwi.h"
+
+#define SCL_MASK (1 << USI_TWI_SCL)
+#define SDA_MASK (1 << USI_TWI_SDA)
+
+//Two wire mode, counter clocked by the software strobe on both edges
+#define USI_TWI_CONTROL ((1 << USIWM1) | (1 << USICS1) | (1 << USICLK))
+#define USI_TWI_STROBE (USI_TWI_CONTROL | (1 << USITC))
+
+//Clear the flags and preset the 4 bit counter to overflow after edges
+#define USI_TWI_COUNT(edges) \
+    ((1 << USISIF) | (1 << USIOIF) | (1 << USIPF) | (1 << USIDC) | (((16 - (edges)) & 0x0F) << USICNT0))
+
+#define USI_TWI_BYTE USI_TWI_COUNT(16)
+#define USI_TWI_BIT USI_TWI_COUNT(2)
+
+void init_usi_twi(void)
+{
+    //In two wire mode a HIGH port bit only releases the line
+    USI_TWI_PORT |= SCL_MASK | SDA_MASK;
+    USI_TWI_DDR |= SCL_MASK | SDA_MASK;
+    
+    USIDR = 0xFF;
+    USICR = USI_TWI_CONTROL;
+    USISR = USI_TWI_BYTE;
+}
+
+void release_usi_twi(void)
+{
+    USICR = 0x00;
+    
+    USI_TWI_DDR &= ~(SCL_MASK | SDA_MASK);
+    USI_TWI_PORT &= ~(SCL_MASK | SDA_MASK);
+}
+
+//Clock bits through the USI until the counter overflows
+//Each HIGH period waits for a slave stretching the clock
+//Returns what was sampled, SDA is driven from USIDR again afterwards
+static uint8_t transfer(uint8_t count)
+{
+    USISR = count;
+    
+    do
+    {
+        _delay_us(USI_TWI_LOW_US);
+        
+        //SCL HIGH, the USI samples SDA on this edge
+        USICR = USI_TWI_STROBE;
+        loop_until_bit_is_set(USI_TWI_PIN, USI_TWI_SCL);
+        _delay_us(USI_TWI_HIGH_US);
+        
+        //SCL LOW, the USI shifts out the next bit
+        USICR = USI_TWI_STROBE;
+    }
+    while(!(USISR & (1 << USIOIF)));
+    
+    _delay_us(USI_TWI_LOW_US);
+    
+    uint8_t data = USIDR;
+    
+    USIDR = 0xFF;
+    USI_TWI_DDR |= SDA_MASK;
+    
+    return data;
+}
+
+uint8_t usi_twi_start(uint8_t address)
+{
+    //SDA is already released, for a repeated start SCL is LOW
+    USI_TWI_PORT |= SCL_MASK;
+    loop_until_bit_is_set(USI_TWI_PIN, USI_TWI_SCL);
+    _delay_us(USI_TWI_LOW_US);
+    
+    //SDA falls while SCL is HIGH
+    USI_TWI_PORT &= ~SDA_MASK;
+    _delay_us(USI_TWI_HIGH_US);
+    USI_TWI_PORT &= ~SCL_MASK;
+    USI_TWI_PORT |= SDA_MASK;
+    
+    if(usi_twi_write(address))
+        return 1;
+    
+    usi_twi_stop();
+    return 0;
+}
+
+uint8_t usi_twi_write(uint8_t data)
+{
+    USIDR = data;
+    transfer(USI_TWI_BYTE);
+    
+    //Slave holds SDA LOW through the ninth clock to acknowledge
+    USI_TWI_DDR &= ~SDA_MASK;
+    
+    return !(transfer(USI_TWI_BIT) & 0x01);
+}
+
+uint8_t usi_twi_read(uint8_t last)
+{
+    USI_TWI_DDR &= ~SDA_MASK;
+    uint8_t data = transfer(USI_TWI_BYTE);
+    
+    //LOW acknowledges and asks for another byte
+    USIDR = last ? 0xFF : 0x00;
+    transfer(USI_TWI_BIT);
+    
+    return data;
+}
+
+void usi_twi_stop(void)
+{
+    //SDA rises while SCL is HIGH
+    USI_TWI_PORT &= ~SDA_MASK;
+    USI_TWI_PORT |= SCL_MASK;
+    loop_until_bit_is_set(USI_TWI_PIN, USI_TWI_SCL);
+    _delay_us(USI_TWI_HIGH_US);
+    
+    USI_TWI_PORT |= SDA_MASK;
+    _delay_us(USI_TWI_LOW_US);
+}
+
+#endif
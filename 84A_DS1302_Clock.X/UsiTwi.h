@@ -0,0 +1,67 @@
+/*
+ * File:   UsiTwi.h
+ * Author: TallDwarf
+ *
+ * I2C master on the USI in two wire mode
+ * The USI shifts the bits and drives SDA, SCL is strobed from software
+ * so the bus rate comes from the delays below
+ */
+
+#ifndef USITWI_H
+#define	USITWI_H
+
+#include <avr/io.h>
+#include "Board.h"
+
+#ifndef F_CPU
+#define F_CPU 8000000UL
+#endif
+
+//Pins come from the board table, the USI only works on USCK and DI
+#if !BOARD_SAME_PORT(BOARD_TIME_SCL, BOARD_TIME_SDA)
+#error "I2C clock and data must both be on the USI port"
+#endif
+
+#define USI_TWI_PORT BOARD_PORT(BOARD_TIME_SCL)
+#define USI_TWI_PIN BOARD_PIN(BOARD_TIME_SCL)
+#define USI_TWI_DDR BOARD_DDR(BOARD_TIME_SCL)
+#define USI_TWI_SCL BOARD_BIT(BOARD_TIME_SCL)
+#define USI_TWI_SDA BOARD_BIT(BOARD_TIME_SDA)
+
+//1 = 400kHz, only for parts rated for it, the DS1307 is 100kHz only
+#ifndef USI_TWI_FAST
+#define USI_TWI_FAST 0
+#endif
+
+//Minimum SCL LOW and HIGH times in us
+#if USI_TWI_FAST
+#define USI_TWI_LOW_US 1.3
+#define USI_TWI_HIGH_US 0.6
+#else
+#define USI_TWI_LOW_US 4.7
+#define USI_TWI_HIGH_US 4.0
+#endif
+
+//Read/write bit of the address byte
+#define USI_TWI_WRITE 0
+#define USI_TWI_READ 1
+
+//Release both lines to the bus pull ups and hand them to the USI
+void init_usi_twi(void);
+
+//Turn the USI off and leave both lines as inputs with no pull ups
+void release_usi_twi(void);
+
+//Start, or repeated start, and send the address byte
+//Returns FALSE and stops the bus if nothing acknowledged
+uint8_t usi_twi_start(uint8_t address);
+
+//Returns FALSE if the byte was not acknowledged
+uint8_t usi_twi_write(uint8_t data);
+
+//last = TRUE does not acknowledge the byte, ending the read
+uint8_t usi_twi_read(uint8_t last);
+
+void usi_twi_stop(void);
+
+#endif	/* USITWI_H */
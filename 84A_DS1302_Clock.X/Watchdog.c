@@ -0,0 +1,84 @@
+#include "Watchdog.h"
+
+//Copied from MCUSR before main, kept out of .bss so startup leaves it alone
+static uint8_t resetFlags __attribute__((section(".noinit")));
+
+static uint8_t watchdogTasks = 0;
+static uint8_t watchdogCheckins = 0;
+
+//What RTC RAM holds, so saves only write changes
+static uint8_t savedState[WATCHDOG_STATE_SIZE];
+
+//A watchdog reset leaves the watchdog running at its shortest timeout
+//and WDRF set keeps it on, stop it before startup code can overrun it
+void watchdog_early(void) __attribute__((naked, used, section(".init3")));
+
+void watchdog_early(void)
+{
+    resetFlags = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+}
+
+uint8_t watchdog_was_reset(void)
+{
+    return (resetFlags & (1 << WDRF)) ? 1 : 0;
+}
+
+void watchdog_start(uint8_t tasks)
+{
+    watchdogTasks = tasks;
+    watchdogCheckins = 0;
+    
+    wdt_enable(WATCHDOG_TIMEOUT);
+}
+
+void watchdog_checkin(uint8_t task)
+{
+    watchdogCheckins |= task;
+    
+    if((watchdogCheckins & watchdogTasks) == watchdogTasks)
+    {
+        wdt_reset();
+        watchdogCheckins = 0;
+    }
+}
+
+static uint8_t state_check(const uint8_t* state)
+{
+    uint8_t check = WATCHDOG_CHECK_SEED;
+    
+    for(uint8_t i = 0; i < WATCHDOG_STATE_SIZE; ++i)
+        check = (check << 1 | check >> 7) ^ state[i];
+    
+    return check;
+}
+
+uint8_t watchdog_restore(const uint8_t* ram, uint8_t* state)
+{
+    for(uint8_t i = 0; i < WATCHDOG_STATE_SIZE; ++i)
+    {
+        savedState[i] = ram[WATCHDOG_RAM_INDEX + i];
+        state[i] = savedState[i];
+    }
+    
+    return ram[WATCHDOG_RAM_INDEX + WATCHDOG_STATE_SIZE] == state_check(state);
+}
+
+void watchdog_save(const uint8_t* state)
+{
+    uint8_t changed = 0;
+    
+    for(uint8_t i = 0; i < WATCHDOG_STATE_SIZE; ++i)
+    {
+        if(savedState[i] != state[i])
+        {
+            savedState[i] = state[i];
+            queue_ram_rtc(WATCHDOG_RAM_INDEX + i, state[i]);
+            changed = 1;
+        }
+    }
+    
+    if(changed)
+        queue_ram_rtc(WATCHDOG_RAM_INDEX + WATCHDOG_STATE_SIZE, state_check(state));
+}
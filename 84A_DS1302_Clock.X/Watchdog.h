@@ -0,0 +1,61 @@
+/*
+ * File:   Watchdog.h
+ * Author: TallDwarf
+ *
+ * Watchdog supervision of the main loop and a small warm restart state
+ * kept in battery backed RTC RAM
+ *
+ * Each task checks in once per pass, the watchdog is only reset once
+ * every task has, so one task stuck or skipped is enough to restart
+ * Power down uses the watchdog as a wake up timer and turns it off, arm
+ * it again with watchdog_start afterwards
+ */
+
+#ifndef WATCHDOG_H
+#define	WATCHDOG_H
+
+#include <avr/io.h>
+#include <avr/wdt.h>
+#include "Rtc.h"
+#include "EventLog.h"
+
+//Longer than a Timer 1 tick so the tick can be a task
+#ifndef WATCHDOG_TIMEOUT
+#define WATCHDOG_TIMEOUT WDTO_1S
+#endif
+
+//RTC RAM bytes holding the state, inside the settings block of EventLog.h
+//The byte after the state is its check byte
+#ifndef WATCHDOG_RAM_INDEX
+#define WATCHDOG_RAM_INDEX 1
+#endif
+
+#define WATCHDOG_STATE_SIZE 4
+#define WATCHDOG_CHECK_SEED 0xA5
+
+//RAM bursts always start at byte 0, this many cover the state and check
+#define WATCHDOG_RAM_END (WATCHDOG_RAM_INDEX + WATCHDOG_STATE_SIZE + 1)
+
+#if WATCHDOG_RAM_INDEX + WATCHDOG_STATE_SIZE >= EVENTLOG_RAM_HEAD
+#error "Watchdog state runs into the event log"
+#endif
+
+//Reset was caused by the watchdog, MCUSR itself is cleared before main
+uint8_t watchdog_was_reset(void);
+
+//Arm the watchdog, tasks is the mask of tasks that must check in
+void watchdog_start(uint8_t tasks);
+
+void watchdog_checkin(uint8_t task);
+
+//Take the state from ram, at least WATCHDOG_RAM_END bytes of RTC RAM
+//read from byte 0, so boot can share the burst with other settings
+//Returns TRUE if it is intact
+//Call at boot and again after anything else wrote RTC RAM, later saves
+//only write what changed since
+uint8_t watchdog_restore(const uint8_t* ram, uint8_t* state);
+
+//Queue writes for whatever changed in the state, call commit_rtc afterwards
+void watchdog_save(const uint8_t* state);
+
+#endif	/* WATCHDOG_H */
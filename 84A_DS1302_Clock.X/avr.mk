@@ -0,0 +1,105 @@
+#
+# Standalone avr-gcc build for Linux, MPLAB is not needed
+#
+# Builds each optimisation variant into avr-build/<variant>/ and reports
+# flash and RAM side by side. bench runs each variant in simavr with the
+# Bench.h markers and compares cycles on the hot paths
+#
+# Usage: make -f avr.mk [all|size|bench|clean] [VARIANTS="Os O2-lto"]
+#        make -f avr.mk bench FAULT_INJECT=20
+#        make -f avr.mk RTC_BACKEND=RTC_DS1307 BUILD=avr-build-ds1307
+#
+# Needs avr-gcc and avr-libc, bench also needs simavr and python3
+# Not yet run with a real toolchain, see MEASUREMENTS.md
+# simavr has no RTC, bench times the free running path without a clock
+#
+
+MCU = attiny84a
+F_CPU = 8000000UL
+FLASH_SIZE = 8192
+RAM_SIZE = 512
+
+CC = avr-gcc
+OBJCOPY = avr-objcopy
+SIZE = avr-size
+SIMAVR = simavr
+SIMAVR_INCLUDE = /usr/include/simavr/avr
+PYTHON = python3
+
+#Wall clock time each variant runs in the simulator
+BENCH_SECONDS = 5
+
+TARGET = 84A_DS1302_Clock
+BUILD = avr-build
+SOURCES = $(wildcard *.c)
+HEADERS = $(wildcard *.h)
+
+#Same code generation options as the MPLAB project
+CFLAGS = -mmcu=$(MCU) -DF_CPU=$(F_CPU) -std=gnu99 -Wall \
+	-ffunction-sections -fdata-sections -fpack-struct -fshort-enums \
+	-funsigned-char -funsigned-bitfields
+LDFLAGS = -mmcu=$(MCU) -Wl,--gc-sections
+
+#Board RTC, see Board.h, use a separate BUILD so objects are not mixed
+ifdef RTC_BACKEND
+CFLAGS += -DRTC_BACKEND=$(RTC_BACKEND)
+endif
+
+#Variant name and its optimisation flags, LTO flags go to the link too
+VARIANTS = Os O2 Os-lto O2-lto
+FLAGS_Os = -Os
+FLAGS_O2 = -O2
+FLAGS_Os-lto = -Os -flto
+FLAGS_O2-lto = -O2 -flto
+
+#simavr finds its setup in .mmcu, which has to survive --gc-sections
+BENCH_FLAGS = -DBENCH -DSIM_TRACE -I$(SIMAVR_INCLUDE) \
+	-Wl,--undefined=_mmcu,--section-start=.mmcu=0x910000
+
+#FAULT_INJECT=N hangs the loop after N ticks, bench then shows the time
+#from the hang to the watchdog reset and from the reset to the first frame
+ifdef FAULT_INJECT
+BENCH_FLAGS += -DFAULT_INJECT=$(FAULT_INJECT)
+endif
+
+.PHONY: all size bench clean
+
+all: $(VARIANTS:%=$(BUILD)/%/$(TARGET).hex) size
+
+#$(1) build directory, $(2) compile and link flags
+define VARIANT
+$(BUILD)/$(1)/%.o: %.c $(HEADERS) | $(BUILD)/$(1)
+	$(CC) $(CFLAGS) $(2) -c $$< -o $$@
+
+$(BUILD)/$(1)/$(TARGET).elf: $(SOURCES:%.c=$(BUILD)/$(1)/%.o)
+	$(CC) $(LDFLAGS) $(2) $$^ -o $$@
+
+$(BUILD)/$(1)/$(TARGET).hex: $(BUILD)/$(1)/$(TARGET).elf
+	$(OBJCOPY) -O ihex -R .eeprom -R .mmcu $$< $$@
+
+$(BUILD)/$(1):
+	mkdir -p $$@
+endef
+
+$(foreach variant,$(VARIANTS),$(eval $(call VARIANT,$(variant),$(FLAGS_$(variant)))))
+$(foreach variant,$(VARIANTS),$(eval $(call VARIANT,$(variant)-bench,$(FLAGS_$(variant)) $(BENCH_FLAGS))))
+
+#Flash is code plus initialised data, RAM is data plus bss
+size: $(VARIANTS:%=$(BUILD)/%/$(TARGET).elf)
+	@printf "%-8s %10s %10s\n" variant flash ram
+	@for variant in $(VARIANTS); do \
+		$(SIZE) -A $(BUILD)/$$variant/$(TARGET).elf | awk -v name=$$variant \
+			'$$1 == ".text" || $$1 == ".data" { flash += $$2 } \
+			$$1 == ".data" || $$1 == ".bss" || $$1 == ".noinit" { ram += $$2 } \
+			END { printf "%-8s %5d %3d%% %5d %3d%%\n", name, flash, flash * 100 / $(FLASH_SIZE), ram, ram * 100 / $(RAM_SIZE) }'; \
+	done
+
+#simavr writes the trace on exit, SIGINT lets it finish the file
+$(BUILD)/%-bench/bus_trace.vcd: $(BUILD)/%-bench/$(TARGET).elf
+	cd $(@D) && timeout -s INT $(BENCH_SECONDS) $(SIMAVR) $(TARGET).elf || true
+
+bench: $(VARIANTS:%=$(BUILD)/%-bench/bus_trace.vcd)
+	$(PYTHON) tools/decode_trace.py $^
+
+clean:
+	rm -rf $(BUILD)
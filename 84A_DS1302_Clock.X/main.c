@@ -7,15 +7,22 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 
-#define TIME_CE PORTA7
-#define TIME_CE_PORT PORTA
-#define TIME_CLOCK PORTB0
-#define TIME_CLOCK_PORT PORTB
-#define TIME_DATA PORTB1
-#define TIME_DATA_PORT PORTB
-
-#include "DS1302.h"
+#include "Board.h"
+#include "Rtc.h"
+#include "Display.h"
+#include "BrightnessCurve.h"
+#include "Alarm.h"
+#include "Calendar.h"
+#include "Dst.h"
+#include "Serial.h"
+#include "Protocol.h"
+#include "Power.h"
+#include "EventLog.h"
+#include "TempComp.h"
+#include "Bench.h"
+#include "Watchdog.h"
 
 //TIMER prescalers 
 #define N_1(TIMER) (1 << CS ## TIMER ## 0)
@@ -24,20 +31,29 @@
 #define N_256(TIMER) (1 << CS ## TIMER ## 2)
 #define N_1024(TIMER) (1 << CS ## TIMER ## 2 | 1 << CS ## TIMER ## 0)
 
-#define DIGIT_DATA PORTA0
-#define DIGIT_CLOCK PORTA1
-#define DIGIT_LATCH PORTA2
-#define DIGIT_CLEAR PORTA4
-#define DIGIT_OUTPUT PORTB2
+#define DIGIT_CLEAR BOARD_BIT(BOARD_DIGIT_CLEAR)
+#define DIGIT_CLEAR_PORT BOARD_PORT(BOARD_DIGIT_CLEAR)
+#define DIGIT_OUTPUT BOARD_BIT(BOARD_DIGIT_OUTPUT)
+#define DIGIT_OUTPUT_PORT BOARD_PORT(BOARD_DIGIT_OUTPUT)
+
+#define LEFT_BUTTON BOARD_BIT(BOARD_LEFT_BUTTON)
+#define LEFT_BUTTON_PIN BOARD_PIN(BOARD_LEFT_BUTTON)
+#define CENTER_BUTTON BOARD_BIT(BOARD_CENTER_BUTTON)
+#define CENTER_BUTTON_PIN BOARD_PIN(BOARD_CENTER_BUTTON)
+#define RIGHT_BUTTON BOARD_BIT(BOARD_RIGHT_BUTTON)
+#define RIGHT_BUTTON_PIN BOARD_PIN(BOARD_RIGHT_BUTTON)
 
-#define LEFT_BUTTON PINA5
-#define LEFT_BUTTON_PIN PINA
-#define CENTER_BUTTON PINB3
-#define CENTER_BUTTON_PIN PINB
-#define RIGHT_BUTTON PINA6
-#define RIGHT_BUTTON_PIN PINA
+#define BRIGHTNESS_PIN BOARD_BIT(BOARD_BRIGHTNESS)
 
-#define BRIGHTNESS_PIN PORTA3
+//Backup charger, DS1302 only, enable on boards with a supercap or rechargeable cell
+//e.g. DS1302_TRICKLE(DS1302_DIODES_1, DS1302_RESISTOR_2K)
+#ifndef TRICKLE_CHARGE
+#define TRICKLE_CHARGE DS1302_TRICKLE_OFF
+#endif
+
+#if !IS_VALID_TRICKLE(TRICKLE_CHARGE)
+#error "TRICKLE_CHARGE is a pattern the DS1302 datasheet marks invalid"
+#endif
 
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
@@ -48,7 +64,8 @@
 #define TRUE 1
 #define FALSE 0
 
-#define MIN_BRIGHTNESS 60
+//Light sensor filter, new reading weighs 1 / (1 << BRIGHTNESS_FILTER_SHIFT)
+#define BRIGHTNESS_FILTER_SHIFT 3
 
 //Number of timer ticks to generate a second
 #define ONE_SECOND_MULTIPLE 2
@@ -56,6 +73,111 @@
 //5 Second delay
 #define MENU_TIMEOUT_MAX ONE_SECOND_MULTIPLE * 5
 
+//Flash display for 1 minute when an alarm goes off
+#define ALARM_RING_MAX ONE_SECOND_MULTIPLE * 60
+
+//Timer 0 overflows per input tick, 8MHz / 8 / 256 / 39 = ~100Hz
+#define INPUT_TICK_DIVIDER 39
+
+//Button hold to repeat, in input ticks
+//First repeat after REPEAT_DELAY, REPEAT_SLOW_COUNT repeats at 2Hz,
+//then 10Hz until REPEAT_COARSE_COUNT, then steps of 10 at 4Hz
+#define REPEAT_DELAY 50
+#define REPEAT_SLOW 50
+#define REPEAT_FAST 10
+#define REPEAT_COARSE 25
+#define REPEAT_SLOW_COUNT 2
+#define REPEAT_COARSE_COUNT 12
+#define REPEAT_COARSE_STEP 10
+
+//Timer 1 counts per 0.5 second tick, 8MHz / 64 / 2
+#define TIMER1_HALF_SECOND 62500
+
+//Phase lock to the RTC seconds edge
+//States
+#define PHASE_FREE 0
+#define PHASE_HUNTING 1
+#define PHASE_LOCKED 2
+//Temperature is learned, seconds are counted locally and the RTC is
+//only read at the minute rollover
+#define PHASE_COASTING 3
+//Ticks to poll for an edge before giving up, a halted clock never rolls
+#define PHASE_HUNT_TICKS 4
+//Largest period trim in Timer 1 counts, ~3% covers the internal oscillator
+#define PHASE_TRIM_MAX 2048
+//Tick periods are kept in 1/16 Timer 1 counts, the ISR spreads the fraction
+#define PHASE_FRACTION_BITS 4
+//Locked, the second read of each second is taken this many Timer 1
+//counts before the edge tick instead of half way, ~2ms. A roll seen there
+//means the tick is late and locks again at once, a roll missing on the
+//edge tick means it is early. Must outlast a loop pass
+#define PHASE_CHECK_COUNTS 250
+//Coasting on a learned period only needs to stay early, ~80ppm is ~0.3s an hour
+#define PHASE_COAST_BIAS 80
+//Coast this long before measuring the period against the RTC again
+#define PHASE_RESYNC_MINUTES 60
+//Ticks between temperature readings
+#define PHASE_TEMPERATURE_TICKS 16
+//First lock has no measured period, hunt again from this tick (half way
+//between edges) to measure it before the error grows
+#define PHASE_MEASURE_TICKS 7
+
+//Stopwatch/countdown, Timer 1 compare B splits each 0.5s tick into
+//TIMER_STEPS_PER_TICK hundredths so it runs off the phase locked tick
+#define TIMER_STEPS_PER_TICK 50
+#define TIMER_OFF 0
+#define TIMER_STOPWATCH 1
+#define TIMER_COUNTDOWN 2
+//Stopwatch wraps after 99:59
+#define TIMER_STOPWATCH_MAX 6000
+//Countdown start in seconds, 1 - 99
+#define TIMER_COUNTDOWN_DEFAULT 30
+
+//Main loop tasks, the watchdog is fed once every one of them checked in
+#define TASK_INPUT (1 << 0)
+#define TASK_TIME (1 << 1)
+#define TASK_RENDER (1 << 2)
+#define TASK_BRIGHTNESS (1 << 3)
+//Timer 1 tick seen by the loop, a stopped timer restarts as well
+#define TASK_TICK (1 << 4)
+#define TASK_ALL (TASK_INPUT | TASK_TIME | TASK_RENDER | TASK_BRIGHTNESS | TASK_TICK)
+
+//Warm restart state, saved to RTC RAM as it changes
+#define WARM_MENU 0
+#define WARM_BRIGHTNESS 1
+#define WARM_TIMER_MODE 2
+#define WARM_TIMER_PRESET 3
+
+//RTC RAM byte set to CLOCK_MARKER along with the time, anything else
+//means the backup supply was lost and RAM and clock hold garbage
+#ifndef CLOCK_RAM_INDEX
+#define CLOCK_RAM_INDEX 6
+#endif
+
+#define CLOCK_MARKER 0x5A
+
+#if CLOCK_RAM_INDEX == DST_RAM_INDEX || CLOCK_RAM_INDEX >= EVENTLOG_RAM_HEAD || \
+        (CLOCK_RAM_INDEX >= WATCHDOG_RAM_INDEX && CLOCK_RAM_INDEX < WATCHDOG_RAM_END)
+#error "Clock marker shares a RAM byte with another setting"
+#endif
+
+//RTC RAM read from byte 0 at boot, marker and warm state in one burst
+#if CLOCK_RAM_INDEX >= WATCHDOG_RAM_END
+#define BOOT_RAM_SIZE (CLOCK_RAM_INDEX + 1)
+#else
+#define BOOT_RAM_SIZE WATCHDOG_RAM_END
+#endif
+
+//Menu fields in Menu_State.enabled, one bit each
+#define MENU_FIRST_FIELD (1 << 0)
+#define MENU_RESERVED_FIELD (1 << 5)
+#define MENU_LAST_FIELD (1 << 6)
+
+//Time data set field access
+#define TIME(field) DS1302_GET(time_ds1302, DS1302_F_ ## field)
+#define SET_TIME(field, value) DS1302_SET(time_ds1302, DS1302_F_ ## field, value)
+#define TOGGLE_TIME(field) DS1302_TOGGLE(time_ds1302, DS1302_F_ ## field)
+
 //Pin held high and buttons pulls it low
 #define PRESSED(Old_state, New_state) (Old_state == HIGH && New_state == LOW)
 #define RELEASED(Old_state, New_state) (Old_state == LOW && New_state == HIGH)
@@ -69,7 +191,8 @@ typedef union
         uint8_t edit_12_24 : 1;
         uint8_t edit_Date : 1;
         uint8_t edit_Month : 1; 
-        uint8_t edit_Weekday : 1;
+        //Weekday follows from the date
+        uint8_t reserved : 1;
         uint8_t edit_Year : 1;
         uint8_t selecting : 1;
     } Menu_Data;
@@ -79,6 +202,8 @@ typedef union
         uint8_t enabled : 7;
         uint8_t setting : 1;
     }Menu_State;
+    //Whole byte for saving and restoring
+    uint8_t Menu_Raw;
 } Menu;
 
 typedef struct
@@ -98,38 +223,96 @@ typedef struct
     uint8_t Led : 1;
     uint8_t Save : 1;
     uint8_t FlipFlop : 1;
-    uint8_t Time : 5;    
+    uint8_t Power : 1;
+    uint8_t Time : 4;    
 } Pending;
 
 //Time data set
-DS1302_DATA_SET time_ds1302 = 
-{
-    .seconds = 0,
-    .secondsX10 = 0,
-    .clockHalt = 0,
-    .minutes = 0,
-    .minutesX10 = 3,
-    .H12.hour = 8,
-    .H12.hourX10 = 0,
-    .H12.hour_AM_PM = 1,
-    .H12.hour_12_24 = 1,
-    .date = 2,
-    .dateX10 = 1,
-    .month = 6,
-    .monthX10 = 0,
-    .day = 5,
-    .year = 0,
-    .yearX10 = 2,
-    .writeProtection = 0,
-    .trickleCharger = 0
+uint8_t time_ds1302[DS1302_IMAGE_SIZE] = 
+{
+    [DS1302_IMAGE_SECOND] = STORE_COMBINE(0, 0),
+    [DS1302_IMAGE_MINUTE] = STORE_COMBINE(3, 0),
+    [DS1302_IMAGE_HOUR] = HOUR_12_COMBINE(0, 8, 1),
+    [DS1302_IMAGE_DATE] = STORE_COMBINE(1, 2),
+    [DS1302_IMAGE_MONTH] = STORE_COMBINE(0, 6),
+    [DS1302_IMAGE_DAY] = 5,
+    [DS1302_IMAGE_YEAR] = STORE_COMBINE(2, 0),
+    [DS1302_IMAGE_WRITE_PROTECTION] = DS1302_UNPROTECT,
+    [DS1302_IMAGE_TRICKLE_CHARGE] = TRICKLE_CHARGE
 };
 
 Menu menu = {0};
 volatile uint8_t menuTimeout = 0;
 
 ButtonState buttons = {0};
+
+//Free running ~100Hz count for button timing
+volatile uint8_t inputTicks = 0;
+uint8_t inputDivider = INPUT_TICK_DIVIDER;
+
+//Hold to repeat state, shared by every menu field
+int8_t repeatDirection = 0;
+uint8_t repeatCount = 0;
+uint8_t repeatTime = 0;
 volatile Pending pending;
 
+//Left/Right lines are the serial port instead of buttons
+uint8_t serialMode = FALSE;
+
+//Ticks since the last re-phase, counted by the Timer 1 ISR
+volatile uint16_t phaseTicks = 0;
+uint8_t phaseState = PHASE_HUNTING;
+uint8_t phaseHuntTicks = 0;
+//Set once a previous edge is known so the period can be measured
+uint8_t phaseReference = FALSE;
+//Set once the tick was trimmed to the measured period
+uint8_t phaseTrimmed = FALSE;
+//Set while the period has not changed since the last lock, only then
+//is a measurement fit to learn from
+uint8_t phaseSteady = FALSE;
+uint8_t phaseCoastMinutes = 0;
+//Set on the half tick while locked, the read before the edge tick is due
+uint8_t phaseCheck = FALSE;
+//Measured period offset from the nominal tick, 1/16 counts
+int16_t phaseOffset = 0;
+
+//Tick period in 1/16 counts, loaded into OCR1A by the Timer 1 ISR
+uint32_t tickPeriod = (uint32_t)TIMER1_HALF_SECOND << PHASE_FRACTION_BITS;
+volatile uint16_t tickBase = TIMER1_HALF_SECOND - 1;
+volatile uint8_t tickFraction = 0;
+uint8_t tickAccumulator = 0;
+
+//Last sensor reading and ticks until the next one
+uint8_t temperature = 0;
+uint8_t temperatureTicks = 0;
+
+//Stopwatch/countdown state, counted in the Timer 1 compare ISRs
+uint8_t timerMode = TIMER_OFF;
+volatile uint8_t timerRunning = FALSE;
+volatile uint8_t timerHundredths = 0;
+volatile uint16_t timerSeconds = 0;
+uint8_t timerPreset = TIMER_COUNTDOWN_DEFAULT;
+//Timer 1 counts per hundredth and hundredths left in the current tick
+volatile uint16_t timerStep = TIMER1_HALF_SECOND / TIMER_STEPS_PER_TICK;
+uint8_t timerPhase = 0;
+
+uint8_t warmState[WATCHDOG_STATE_SIZE];
+
+#ifdef FAULT_INJECT
+//Simulator only, the loop hangs once this many ticks have passed
+uint16_t faultTicks = 0;
+#endif
+
+//Ticks left to flash the display for an alarm
+volatile uint8_t alarmRinging = 0;
+
+//Dithered duty, OCR0A value << BRIGHTNESS_DITHER_BITS plus fraction
+//Current duty ramps towards target one step per dither cycle
+volatile uint16_t brightnessTarget = 128 << BRIGHTNESS_DITHER_BITS;
+uint16_t brightnessDuty = 128 << BRIGHTNESS_DITHER_BITS;
+uint8_t brightnessPhase = 0;
+uint16_t brightnessFilter = 128 << BRIGHTNESS_FILTER_SHIFT;
+
 const uint8_t segmentNumbers[10] = 
 {
     0b11111100, //0
@@ -144,19 +327,14 @@ const uint8_t segmentNumbers[10] =
     0b11100110  //9
 };
 
-uint8_t digits[4] = 
-{
-    0b11111100, 0b11111100, 0b11111100, 0b11111100
-};
-
 ///////////////////////
 //PWM
 //////////////////////
 
 void init_pwm(void)
 {
-    //B2 to output
-    DDRB |= (1 << PORTB2);    
+    //Output enable to output
+    BOARD_DDR(BOARD_DIGIT_OUTPUT) |= BOARD_MASK(BOARD_DIGIT_OUTPUT);    
     
     //start with 50% duty
     OCR0A = 128;
@@ -167,22 +345,61 @@ void init_pwm(void)
     //Non inverting
     TCCR0A |= (1 << COM0A1);
     
-    //Prescaler to 64
-    TCCR0B |= N_64(0);    
+    //Prescaler to 8, 8MHz / 8 / 256 = ~3.9kHz on paper
+    //Dithering 2 bits over 4 periods leaves ~980Hz at 10 bit resolution
+    //Neither frequency has been measured, see MEASUREMENTS.md
+    TCCR0B |= N_8(0);    
+    
+    //Dither and slew duty on overflow
+    TIMSK0 |= (1 << TOIE0);
+}
+
+static inline void set_pwm_duty(uint16_t duty)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        brightnessTarget = duty;
+    }
 }
 
-inline void set_pwm_duty(uint8_t duty)
+//Spread the fraction bits of the duty over successive PWM periods and
+//ramp duty one step per dither cycle so brightness never jumps
+//OCR0A is double buffered and takes the new value at the next BOTTOM
+ISR(TIM0_OVF_vect)
 {
-    OCR0A = duty;
+    BENCH_BEGIN(BENCH_TIMER0_ISR);
+    
+    uint8_t phase = (brightnessPhase + 1) & ((1 << BRIGHTNESS_DITHER_BITS) - 1);
+    brightnessPhase = phase;
+    
+    if(phase == 0)
+    {
+        if(brightnessDuty < brightnessTarget)
+            brightnessDuty++;
+        else if(brightnessDuty > brightnessTarget)
+            brightnessDuty--;
+    }
+    
+    uint8_t fraction = brightnessDuty & ((1 << BRIGHTNESS_DITHER_BITS) - 1);
+    
+    OCR0A = (brightnessDuty >> BRIGHTNESS_DITHER_BITS) + (fraction > phase ? 1 : 0);
+    
+    if(--inputDivider == 0)
+    {
+        inputDivider = INPUT_TICK_DIVIDER;
+        inputTicks++;
+    }
+    
+    BENCH_END(BENCH_TIMER0_ISR);
 }
 
 ///////////////////////
 //ADC
 //////////////////////
 
-inline void init_adc(void)
+static inline void init_adc(void)
 {
-    DDRA &= ~(1 << PORTA3);
+    BOARD_DDR(BOARD_BRIGHTNESS) &= ~BOARD_MASK(BOARD_BRIGHTNESS);
     ADMUX |= (1 << MUX0) | (1 << MUX1); // PA3 as ADC input
     
     // Enable ADC - Do not start ADC - Enable Auto Trigger - Clear Interrupt Flag - Disable Interrupt - prescaler to 128
@@ -191,7 +408,7 @@ inline void init_adc(void)
     
 }
 
-inline void start_adc(void)
+static inline void start_adc(void)
 {
     ADCSRA |= (1 << ADSC);
 }
@@ -201,76 +418,103 @@ uint8_t read_ADC(void)
     //Wait for ADC to finish
     loop_until_bit_is_clear(ADCSRA, ADSC);
 
-    return MAX(MIN_BRIGHTNESS, ADCH);
+    return ADCH;
+}
+
+//Low pass the light sensor then look up the gamma corrected duty
+uint16_t get_brightness(uint8_t adc)
+{
+    brightnessFilter += adc - (brightnessFilter >> BRIGHTNESS_FILTER_SHIFT);
+    
+    return pgm_read_word(&brightness_curve[brightnessFilter >> BRIGHTNESS_FILTER_SHIFT]);
 }
 
 //////////////////////////
 //LED Render
 //////////////////////////
 
-//Shift out all digits
-void write_digits(void)
+//Checks if the leds need updating if they do update segment displays
+void render(void)
 {
-    PORTA &= ~((1 << DIGIT_DATA) | (1 << DIGIT_CLOCK));
-    
-    for(uint8_t digitIndex = 0; digitIndex < 4; ++digitIndex)
+    if(pending.Led)
     {
-        uint8_t data = digits[3 - digitIndex];
-        for(uint8_t i = 0; i < 8; ++i)
-        {
-            PORTA &= ~(1 << DIGIT_CLOCK);          
-            
-            if(data & 0x01)
-                PORTA |= (1 << DIGIT_DATA);                
-            else
-                PORTA &= ~(1 << DIGIT_DATA);
-            
-            NOP2();
-            PORTA |= (1 << DIGIT_CLOCK);
-            NOP2();
-            
-            data = data >> 1;
-        }
+        //Write to 595
+        display_flush();
+        pending.Led = 0;
     }
-    
-    PORTA &= ~(1 << DIGIT_CLOCK);  
-    PORTA &= ~(1 << DIGIT_DATA);
 }
 
-//Checks if the leds need updating if they do update segment displays
-void render(void)
+//SS.hh, or MM:SS once past 99.99 seconds
+void set_timer_digits(void)
 {
-    if(pending.Led)
+    uint16_t seconds;
+    uint8_t hundredths;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
-        //Write to 595        
-        PORTA |= (1 << DIGIT_LATCH);                    
-        write_digits();        
-        PORTA &= ~(1 << DIGIT_LATCH);  
-        pending.Led = 0;
+        seconds = timerSeconds;
+        hundredths = timerHundredths;
+    }
+    
+    uint8_t high = seconds;
+    uint8_t low = hundredths;
+    
+    if(seconds >= 100)
+    {
+        high = seconds / 60;
+        low = seconds % 60;
     }
+    
+    display_set_digit(0, segmentNumbers[GET_X10(high)]);
+    //Decimal point of this digit is the colon line
+    display_set_digit(1, segmentNumbers[GET_X1(high)] | DISPLAY_DP);
+    display_set_digit(2, segmentNumbers[GET_X10(low)]);
+    display_set_digit(3, segmentNumbers[GET_X1(low)]);
+    
+#if DISPLAY_DIGITS > 4
+    for(uint8_t i = 4; i < DISPLAY_DIGITS; ++i)
+        display_set_digit(i, 0x00);
+#endif
+    
+    //Countdown finished
+    if(alarmRinging && pending.FlipFlop)
+        display_clear();
 }
 
 void set_clock_digits(void)
 {
+    //Stopwatch/countdown replaces the clock, the RTC keeps running
+    if(timerMode != TIMER_OFF)
+    {
+        set_timer_digits();
+        return;
+    }
+    
     //If the menu is open
     if(menu.Menu_State.enabled)
     {
+#if DISPLAY_DIGITS > 4
+        //Menu fields only use the first four digits
+        for(uint8_t i = 4; i < DISPLAY_DIGITS; ++i)
+            display_set_digit(i, 0x00);
+#endif
+        
         //Only show minutes and slow flash
         if(menu.Menu_Data.edit_Minutes)
         {
-            digits[0] = 0x00;
-            digits[1] = 0x00;
+            display_set_digit(0, 0x00);
+            display_set_digit(1, 0x00);
             
             
             if(pending.FlipFlop || menu.Menu_State.setting)
             {
-                digits[2] = segmentNumbers[MIN(9, time_ds1302.minutesX10)];
-                digits[3] = segmentNumbers[MIN(9, time_ds1302.minutes)];
+                display_set_digit(2, segmentNumbers[MIN(9, TIME(MINUTES_X10))]);
+                display_set_digit(3, segmentNumbers[MIN(9, TIME(MINUTES))]);
             }
             else
             {
-                digits[2] = 0x00;
-                digits[3] = 0x00;
+                display_set_digit(2, 0x00);
+                display_set_digit(3, 0x00);
             }
         }
         else if(menu.Menu_Data.edit_Hours)
@@ -279,121 +523,106 @@ void set_clock_digits(void)
             {
                 if(IS_24_HOUR(time_ds1302))
                 {
-                    digits[0] = segmentNumbers[MIN(9, time_ds1302.H24.hourX10)];
-                    digits[1] = segmentNumbers[MIN(9, time_ds1302.H24.hour)];
+                    display_set_digit(0, segmentNumbers[MIN(9, TIME(HOUR24_X10))]);
+                    display_set_digit(1, segmentNumbers[MIN(9, TIME(HOUR))]);
                 }
                 else
                 {    
-                    digits[0] = segmentNumbers[MIN(9, time_ds1302.H12.hourX10)];
-                    digits[1] = segmentNumbers[MIN(9, time_ds1302.H12.hour)];
+                    display_set_digit(0, segmentNumbers[MIN(9, TIME(HOUR12_X10))]);
+                    display_set_digit(1, segmentNumbers[MIN(9, TIME(HOUR))]);
                 }
             }
             else
             {
-                digits[0] = 0x00;
-                digits[1] = 0x00;
+                display_set_digit(0, 0x00);
+                display_set_digit(1, 0x00);
             }
             
-            digits[2] = 0x00;
-            digits[3] = 0x00;
+            display_set_digit(2, 0x00);
+            display_set_digit(3, 0x00);
         }
         else if(menu.Menu_Data.edit_12_24)
         {
             if(IS_24_HOUR(time_ds1302))
             {
-                digits[0] = 0x00;
-                digits[1] = 0x00;
+                display_set_digit(0, 0x00);
+                display_set_digit(1, 0x00);
                 
                 if(pending.FlipFlop || menu.Menu_State.setting)
                 {
-                    digits[2] = segmentNumbers[2];
-                    digits[3] = segmentNumbers[4];
+                    display_set_digit(2, segmentNumbers[2]);
+                    display_set_digit(3, segmentNumbers[4]);
                 }
                 else
                 {
-                    digits[2] = 0x00;
-                    digits[3] = 0x00;
+                    display_set_digit(2, 0x00);
+                    display_set_digit(3, 0x00);
                 }                       
             }
             else
             {
                 if(pending.FlipFlop || menu.Menu_State.setting)
                 {
-                    digits[0] = segmentNumbers[1];
-                    digits[1] = segmentNumbers[2];
+                    display_set_digit(0, segmentNumbers[1]);
+                    display_set_digit(1, segmentNumbers[2]);
                 }
                 else
                 {
-                    digits[0] = 0x00;
-                    digits[1] = 0x00;
+                    display_set_digit(0, 0x00);
+                    display_set_digit(1, 0x00);
                 }
                 
-                digits[2] = 0x00;
-                digits[3] = 0x00;
-            }
-        }
-        else if(menu.Menu_Data.edit_Weekday)
-        {
-            digits[0] = 0x00;
-            digits[1] = 0x00;
-            digits[2] = 0x00;
-            
-            if(pending.FlipFlop || menu.Menu_State.setting)
-            {
-                digits[3] = segmentNumbers[MIN(7, time_ds1302.day)];
+                display_set_digit(2, 0x00);
+                display_set_digit(3, 0x00);
             }
-            else
-            {
-                digits[3] = 0x00;
-            }   
         }
         else if(menu.Menu_Data.edit_Date)
         {
             if(pending.FlipFlop || menu.Menu_State.setting)
             {
-                digits[0] = segmentNumbers[MIN(3, time_ds1302.dateX10)];
-                digits[1] = segmentNumbers[MIN(9, time_ds1302.date)];
+                display_set_digit(0, segmentNumbers[MIN(3, TIME(DATE_X10))]);
+                display_set_digit(1, segmentNumbers[MIN(9, TIME(DATE))]);
             }
             else
             {
-                digits[0] = 0x00;
-                digits[1] = 0x00;
+                display_set_digit(0, 0x00);
+                display_set_digit(1, 0x00);
             }
             
-            digits[2] = 0x00;
-            digits[3] = 0x00;
+            display_set_digit(2, 0x00);
+            display_set_digit(3, 0x00);
         }
         else if(menu.Menu_Data.edit_Month)
         {
-            digits[0] = 0x00;
-            digits[1] = 0x00;
+            display_set_digit(0, 0x00);
+            display_set_digit(1, 0x00);
             
             if(pending.FlipFlop || menu.Menu_State.setting)
             {
-                digits[2] = segmentNumbers[MIN(1, time_ds1302.monthX10)];
-                digits[3] = segmentNumbers[MIN(9, time_ds1302.month)];
+                display_set_digit(2, segmentNumbers[MIN(1, TIME(MONTH_X10))]);
+                display_set_digit(3, segmentNumbers[MIN(9, TIME(MONTH))]);
             }
             else
             {
-                digits[2] = 0x00;
-                digits[3] = 0x00;
+                display_set_digit(2, 0x00);
+                display_set_digit(3, 0x00);
             }
         }
         else if(menu.Menu_Data.edit_Year)
         {
             if(pending.FlipFlop || menu.Menu_State.setting)
             {
-                digits[0] = segmentNumbers[2];
-                digits[1] = segmentNumbers[0];
-                digits[2] = segmentNumbers[MIN(9, time_ds1302.yearX10)];
-                digits[3] = segmentNumbers[MIN(9, time_ds1302.year)];
+                display_set_digit(0, segmentNumbers[2]);
+                display_set_digit(1, segmentNumbers[0]);
+                display_set_digit(2, segmentNumbers[MIN(9, TIME(YEAR_X10))]);
+                display_set_digit(3, segmentNumbers[MIN(9, TIME(YEAR))]);
             }
             else
             {
-                digits[0] = 0x00;
-                digits[1] = 0x00;
-                digits[2] = 0x00;
-                digits[3] = 0x00;
+                display_set_digit(0, 0x00);
+                display_set_digit(1, 0x00);
+                display_set_digit(2, 0x00);
+                display_set_digit(3, 0x00);
             }            
         }
         
@@ -404,519 +633,1059 @@ void set_clock_digits(void)
     {    
         if(IS_24_HOUR(time_ds1302))
         {
-            digits[0] = segmentNumbers[MIN(2, time_ds1302.H24.hourX10)];
-            digits[1] = segmentNumbers[MIN(9, time_ds1302.H24.hour)];
+            display_set_digit(0, segmentNumbers[MIN(2, TIME(HOUR24_X10))]);
+            display_set_digit(1, segmentNumbers[MIN(9, TIME(HOUR))]);
         }
         else
         {    
-            digits[0] = segmentNumbers[MIN(1, time_ds1302.H12.hourX10)];
-            digits[1] = segmentNumbers[MIN(9, time_ds1302.H12.hour)];
+            display_set_digit(0, segmentNumbers[MIN(1, TIME(HOUR12_X10))]);
+            display_set_digit(1, segmentNumbers[MIN(9, TIME(HOUR))]);
         }
 
-            digits[2] = segmentNumbers[MIN(5, time_ds1302.minutesX10)];
-            digits[3] = segmentNumbers[MIN(9, time_ds1302.minutes)];
+        display_set_digit(2, segmentNumbers[MIN(5, TIME(MINUTES_X10))]);
+        display_set_digit(3, segmentNumbers[MIN(9, TIME(MINUTES))]);
+        
+#if DISPLAY_DIGITS >= 8
+        display_set_digit(4, segmentNumbers[MIN(3, TIME(DATE_X10))]);
+        display_set_digit(5, segmentNumbers[MIN(9, TIME(DATE))]);
+        display_set_digit(6, segmentNumbers[MIN(1, TIME(MONTH_X10))]);
+        display_set_digit(7, segmentNumbers[MIN(9, TIME(MONTH))]);
+#elif DISPLAY_DIGITS >= 6
+        display_set_digit(4, segmentNumbers[MIN(5, TIME(SECONDS_X10))]);
+        display_set_digit(5, segmentNumbers[MIN(9, TIME(SECONDS))]);
+#endif
+        
+        //Flash whole display while an alarm is going off
+        if(alarmRinging && pending.FlipFlop)
+            display_clear();
+    }
+}
+
+uint8_t get_hour_24(void)
+{
+    if(IS_24_HOUR(time_ds1302))
+        return COMBINE(TIME(HOUR24_X10), TIME(HOUR));
+    
+    uint8_t hour = COMBINE(TIME(HOUR12_X10), TIME(HOUR));
+    
+    //12 AM is hour 0, 12 PM is hour 12
+    if(hour == 12)
+        hour = 0;
+    
+    return TIME(AM_PM) ? hour + 12 : hour;
+}
+
+uint16_t get_minute_of_week(void)
+{
+    return ((TIME(DAY) - 1) * ALARM_MINUTES_PER_DAY) + (get_hour_24() * 60) +
+            COMBINE(TIME(MINUTES_X10), TIME(MINUTES));
+}
+
+void set_hour_24(uint8_t hour)
+{
+    if(IS_24_HOUR(time_ds1302))
+    {
+        SET_TIME(HOUR24_X10, GET_X10(hour));
+        SET_TIME(HOUR, GET_X1(hour));
+        return;
+    }
+    
+    SET_TIME(AM_PM, (hour >= 12));
+    if(hour >= 12)
+        hour -= 12;
+    
+    if(hour == 0)
+        hour = 12;
+    
+    SET_TIME(HOUR12_X10, GET_X10(hour));
+    SET_TIME(HOUR, GET_X1(hour));
+}
+
+void sync_dst(void)
+{
+    dst_sync(COMBINE(TIME(YEAR_X10), TIME(YEAR)),
+            COMBINE(TIME(MONTH_X10), TIME(MONTH)),
+            COMBINE(TIME(DATE_X10), TIME(DATE)),
+            get_hour_24());
+    
+    commit_rtc();
+}
+
+//Move the hour register only when daylight saving starts or ends
+void check_dst(void)
+{
+    uint8_t hour = get_hour_24();
+    int8_t change = dst_check(COMBINE(TIME(YEAR_X10), TIME(YEAR)),
+            COMBINE(TIME(MONTH_X10), TIME(MONTH)),
+            COMBINE(TIME(DATE_X10), TIME(DATE)),
+            hour, COMBINE(TIME(MINUTES_X10), TIME(MINUTES)));
+    
+    if(change)
+    {
+        set_hour_24(hour + change);
+        
+        //Goes out with the stored daylight saving state in one commit
+        queue_hour_rtc(time_ds1302[DS1302_IMAGE_HOUR]);
+        commit_rtc();
+        
+        //Alarms in the skipped hour would never match
+        alarm_sync(get_minute_of_week());
+    }
+}
+
+//Clamp date to the length of the month and work out the weekday
+void validate_date(void)
+{
+    uint8_t year = COMBINE(TIME(YEAR_X10), TIME(YEAR));
+    uint8_t month = COMBINE(TIME(MONTH_X10), TIME(MONTH));
+    uint8_t date = COMBINE(TIME(DATE_X10), TIME(DATE));
+    uint8_t days = calendar_days_in_month(year, month);
+    
+    if(date > days)
+    {
+        date = days;
+        SET_TIME(DATE_X10, GET_X10(date));
+        SET_TIME(DATE, GET_X1(date));
     }
+    
+    SET_TIME(DAY, calendar_weekday(year, month, date));
 }
 
-inline void save_time()
+//Look for the next seconds edge on every pass of the main loop
+void hunt_phase(void)
 {
-    //Start clock
-    write_to_ds1302(DS1302_SECOND, 0x00);
+    phaseState = PHASE_HUNTING;
+    phaseHuntTicks = 0;
+    phaseCheck = FALSE;
+}
+
+//Call when the time was changed, the old edge no longer holds
+void unlock_phase(void)
+{
+    hunt_phase();
+    phaseReference = FALSE;
+    phaseTrimmed = FALSE;
+}
+
+static inline void save_time()
+{
+    validate_date();
     
-    //Write new data
-    burst_write_to_ds1302((uint8_t*)&time_ds1302);
+    //Write new data, clearing clock halt in the image also starts the clock
+    SET_TIME(CLOCK_HALT, 0);
+    queue_time_rtc(time_ds1302);
+    log_event(EVENT_TIME_EDITED, get_minute_of_week());
+    
+    //Time jumped, find the next alarm and transition again
+    //Daylight saving state is committed along with the time
+    sync_dst();
+    alarm_sync(get_minute_of_week());
+    unlock_phase();
 }
 
 ///////////////////////
 //Timer 1 - 0.5 second delay
 //////////////////////
 
-inline void init_timer1(void)
+static inline void init_timer1(void)
 {    
-    OCR1AH = 0xF4; 
-    OCR1AL = 0x24;
+    OCR1A = TIMER1_HALF_SECOND - 1;
     TCCR1A = 0x80;
     TCCR1B |= ((1 << WGM12) | N_64(1)); 
-    TIMSK1 |= (1 << OCIE1A);
+    TIMSK1 |= (1 << OCIE1A) | (1 << OCIE1B);
+}
+
+//One hundredth of the stopwatch/countdown
+static inline void timer_step(void)
+{
+    if(!timerRunning)
+        return;
+    
+    if(timerMode == TIMER_STOPWATCH)
+    {
+        if(++timerHundredths == 100)
+        {
+            timerHundredths = 0;
+            
+            if(++timerSeconds == TIMER_STOPWATCH_MAX)
+                timerSeconds = 0;
+        }
+    }
+    else if(timerHundredths > 0)
+    {
+        timerHundredths--;
+    }
+    else if(timerSeconds > 0)
+    {
+        timerHundredths = 99;
+        timerSeconds--;
+    }
+    else
+    {
+        //Countdown done, flash like an alarm
+        timerRunning = FALSE;
+        alarmRinging = ALARM_RING_MAX;
+    }
+    
+    pending.Led = TRUE;
+}
+
+//Remaining hundredths of the tick, compare A counts the first
+ISR(TIM1_COMPB_vect)
+{
+    if(++timerPhase == TIMER_STEPS_PER_TICK)
+        OCR1B = 0xFFFF;
+    else
+        OCR1B += timerStep;
+    
+    timer_step();
 }
 
 ISR(TIM1_COMPA_vect)
 {    
+    BENCH_BEGIN(BENCH_TIMER1_ISR);
+    
     if(menuTimeout > 0)
         --menuTimeout;
     
+    if(alarmRinging > 0)
+        --alarmRinging;
+    
+    ++phaseTicks;
+    
+    //Spread the fraction of the period over the ticks, one count more on a carry
+    tickAccumulator += tickFraction;
+    OCR1A = tickBase + (tickAccumulator >> PHASE_FRACTION_BITS);
+    tickAccumulator &= (1 << PHASE_FRACTION_BITS) - 1;
+    
+    //First hundredth of the tick, compare B runs the rest
+    timerPhase = 1;
+    OCR1B = timerStep;
+    timer_step();
+    
     pending.Time = TRUE;
+    pending.Power = TRUE;
     pending.FlipFlop = ~pending.FlipFlop;
+    
+    BENCH_END(BENCH_TIMER1_ISR);
 }
 
-void update_time()
+//Nominal period plus the measured offset, coasting runs a little short
+//OCR1A follows from the next tick
+void set_tick_period(void)
 {
-    //Every .5 seconds update time with the DS1302 to make sure we are on track
-    if(menu.Menu_State.enabled == FALSE && pending.Time)
-    {            
-        pending.Led = TRUE;
+    uint32_t period = ((uint32_t)TIMER1_HALF_SECOND << PHASE_FRACTION_BITS) + phaseOffset;
+    
+    if(phaseState == PHASE_COASTING)
+        period -= PHASE_COAST_BIAS;
+    
+    tickPeriod = period;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        tickBase = (period >> PHASE_FRACTION_BITS) - 1;
+        tickFraction = period & ((1 << PHASE_FRACTION_BITS) - 1);
+        timerStep = (period >> PHASE_FRACTION_BITS) / TIMER_STEPS_PER_TICK;
+    }
+}
 
-        uint8_t* time_ptr = (uint8_t*)&time_ds1302;
+//Seconds just rolled, restart Timer 1 so ticks land on the edge and
+//the one after lands half way. The blink starts with the display on
+void lock_phase(void)
+{
+    uint16_t counts;
+    uint16_t ticks;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        counts = TCNT1;
+        ticks = phaseTicks;
         
-        //Read only seconds
-        read_from_address_ds1302(DS1302_SECOND, time_ptr);
-
-        //If seconds have reset read all data
-        if(*time_ptr == 0x00)
+        //A compare that has not been serviced yet already reset TCNT1
+        if(TIFR1 & (1 << OCF1A))
+            ticks++;
+        
+        //The hundredths restart with the tick as they would on compare A
+        TCNT1 = 0;
+        TIFR1 = (1 << OCF1A) | (1 << OCF1B);
+        timerPhase = 1;
+        OCR1B = timerStep;
+        timer_step();
+        phaseTicks = 0;
+        pending.FlipFlop = TRUE;
+    }
+    
+    //Edges are exactly whole seconds apart, trim the tick to match
+    uint16_t seconds = (ticks + 1) >> 1;
+    
+    if(phaseReference && seconds > 0)
+    {
+        //Only the odd tick and the counts past it differ from the
+        //current period, so hours long runs fit in 32 bits
+        uint32_t halves = (uint32_t)seconds << 1;
+        int32_t error = ((int32_t)counts << PHASE_FRACTION_BITS) - (int32_t)(halves - ticks) * tickPeriod;
+        int32_t offset = (int32_t)tickPeriod + error / (int32_t)halves - ((int32_t)TIMER1_HALF_SECOND << PHASE_FRACTION_BITS);
+        
+        if(offset > -((int32_t)PHASE_TRIM_MAX << PHASE_FRACTION_BITS) && offset < ((int32_t)PHASE_TRIM_MAX << PHASE_FRACTION_BITS))
         {
-            burst_read_from_ds1302(time_ptr);
+            //A period change part way through would skew the measurement
+            if(phaseSteady)
+                tempcomp_learn(temperature, offset);
+            
+            phaseOffset = offset;
+            phaseTrimmed = TRUE;
         }
-        pending.Time = FALSE;  
-    }        
+    }
+    
+    //Known temperature, the tick can keep the seconds on its own
+    int16_t learned = tempcomp_offset(temperature);
+    
+    if(phaseTrimmed && learned != TEMPCOMP_UNKNOWN)
+    {
+        phaseOffset = learned;
+        phaseState = PHASE_COASTING;
+    }
+    else
+        phaseState = PHASE_LOCKED;
+    
+    phaseReference = TRUE;
+    phaseSteady = TRUE;
+    phaseCoastMinutes = 0;
+    phaseCheck = FALSE;
+    set_tick_period();
+    
+    //TCNT1 was just cleared, the new period can start now
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        OCR1A = tickBase;
+    }
+}
 
-    set_clock_digits();
+//Move the tick to the learned period when the temperature changes bucket
+void update_temperature(void)
+{
+    uint8_t reading = tempcomp_read();
+    uint8_t moved = (tempcomp_bucket(reading) != tempcomp_bucket(temperature));
+    
+    temperature = reading;
+    
+    if(!moved)
+        return;
+    
+    int16_t learned = tempcomp_offset(reading);
+    
+    //Not learned yet, keep the last period and watch the RTC again
+    if(learned != TEMPCOMP_UNKNOWN)
+        phaseOffset = learned;
+    else if(phaseState == PHASE_COASTING)
+        phaseState = PHASE_LOCKED;
+    
+    phaseSteady = FALSE;
+    set_tick_period();
 }
 
-//Store last input value and get new value
-//Debounce done on PCB
-void update_input(void)
+//Minute changed in the image, run what hangs off it
+void roll_minute(void)
 {
-    buttons.Center_Button_Old = buttons.Center_Button_Stat;    
-    buttons.Center_Button_Stat = (CENTER_BUTTON_PIN & (1 << CENTER_BUTTON)) ? 1 : 0;
+    check_dst();
     
-    buttons.Left_Button_Old = buttons.Left_Button_Stat;
-    buttons.Left_Button_Stat = (LEFT_BUTTON_PIN & (1 << LEFT_BUTTON)) ? 1 : 0;
+    if(alarm_check(get_minute_of_week()))
+        alarmRinging = ALARM_RING_MAX;
+}
+
+//Next seconds value in BCD
+uint8_t next_second(uint8_t second)
+{
+    if((second & 0x0F) < 9)
+        return second + 1;
     
-    buttons.Right_Button_Old = buttons.Right_Button_Stat;
-    buttons.Right_Button_Stat = (RIGHT_BUTTON_PIN & (1 << RIGHT_BUTTON)) ? 1 : 0;
+    return (second >= 0x50) ? 0x00 : (second & 0xF0) + 0x10;
 }
 
-void update_menu(void)
+//Count the seconds on the edge ticks, the tick after the predicted
+//rollover reads the new minute and checks the phase is still in half a tick
+void coast_time(void)
 {
-    //If the menu is not currently enabled
-    if(menu.Menu_State.enabled == FALSE)
+    uint8_t* time_ptr = time_ds1302;
+    
+    if(pending.FlipFlop)
     {
-        //Check for any button press to open menu
-        if(PRESSED(buttons.Center_Button_Old, buttons.Center_Button_Stat) ||
-                PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat) || 
-                PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-        {
-            menu.Menu_State.enabled = 0x00;
-            menu.Menu_State.setting = 0x00;
-            menu.Menu_Data.edit_Minutes = TRUE;
-            
-            menuTimeout = MENU_TIMEOUT_MAX;
-            
-            //Stop clock
-            write_to_ds1302(DS1302_SECOND, 0x80);
-        }
-        
+        *time_ptr = next_second(*time_ptr);
         return;
     }
-    else
+    
+    if(*time_ptr != 0x00)
+        return;
+    
+    read_time_rtc(time_ptr);
+    roll_minute();
+    
+    if(*time_ptr != 0x00 || ++phaseCoastMinutes >= PHASE_RESYNC_MINUTES)
+        hunt_phase();
+}
+
+//Locked and the edge tick is less than PHASE_CHECK_COUNTS away
+static inline uint8_t phase_check_due(void)
+{
+    uint16_t counts;
+    
+    if(!phaseCheck)
+        return FALSE;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
     {
-        if(menuTimeout == 0)
-        {
-            menu.Menu_State.enabled = 0x00;
-            menu.Menu_Data.selecting = FALSE;
-            save_time();
-            return;
-        }
+        counts = TCNT1;
     }
     
-    if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-    {
-        if(menu.Menu_Data.selecting == FALSE)
-        {
-            menu.Menu_Data.selecting = TRUE;
-            menuTimeout = MENU_TIMEOUT_MAX;
-        }
-        else
+    return counts >= tickBase - PHASE_CHECK_COUNTS;
+}
+
+void update_time()
+{
+    //Twice a second update time with the RTC to make sure we are on track
+    //While hunting for the seconds edge poll on every pass
+    if(menu.Menu_State.enabled == FALSE && (pending.Time || phaseState == PHASE_HUNTING || phase_check_due()))
+    {            
+        uint8_t tick = pending.Time;
+        
+        if(tick)
+            pending.Led = TRUE;
+        
+        if(phaseState == PHASE_COASTING)
         {
-            menu.Menu_State.enabled = 0x00;
-            menu.Menu_Data.selecting = FALSE;
-            menuTimeout = 0;
-            save_time();
+            coast_time();
+            pending.Time = FALSE;
+            set_clock_digits();
+            return;
         }
-    }
-    
-    if(menu.Menu_Data.edit_Minutes)
-    {
-        if(menu.Menu_Data.selecting == FALSE)
+        
+        //Locked half tick, the read waits until just before the edge tick
+        //An untrimmed tick hunts from here to measure the period instead
+        if(phaseState == PHASE_LOCKED && tick && !pending.FlipFlop)
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Year = 1;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Hours = 1;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            if(!phaseTrimmed && phaseTicks >= PHASE_MEASURE_TICKS)
+                hunt_phase();
+            else
+                phaseCheck = TRUE;
+            
+            pending.Time = FALSE;
+            set_clock_digits();
+            return;
         }
-        else
+
+        uint8_t* time_ptr = time_ds1302;
+        uint8_t lastSecond = *time_ptr;
+        
+        //Read only seconds
+        read_seconds_rtc(time_ptr);
+        
+        uint8_t changed = (*time_ptr != lastSecond);
+        
+        if(phaseState == PHASE_HUNTING)
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
+            if(changed)
             {
-                uint8_t mins = COMBINE(time_ds1302.minutesX10, time_ds1302.minutes);
-                
-                if(mins == 0)
-                    mins = 59;
-                else
-                    mins--;
-                
-                time_ds1302.minutesX10 = GET_X10(mins);
-                time_ds1302.minutes = GET_X1(mins);
-                menuTimeout = MENU_TIMEOUT_MAX;
+                lock_phase();
+                pending.Led = TRUE;
             }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                uint8_t mins = COMBINE(time_ds1302.minutesX10, time_ds1302.minutes);
-//                
-//                if(mins == 59)
-//                    mins = 0;
-//                else
-//                    mins++;
-//                
-//                time_ds1302.minutesX10 = GET_X10(mins);
-//                time_ds1302.minutes = GET_X1(mins);
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            else if(tick && ++phaseHuntTicks > PHASE_HUNT_TICKS)
+                phaseState = PHASE_FREE;
         }
-    }
-    else if(menu.Menu_Data.edit_Hours)
-    {
-        if(menu.Menu_Data.selecting == FALSE)
+        else if(phaseState == PHASE_LOCKED)
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
+            //The roll belongs on the edge tick. Missing there means the
+            //tick is early, find the edge again
+            //Seen on the read just before it means late. A trimmed tick
+            //only moves a little a second and the last check saw no roll,
+            //so the edge has just gone by. Untrimmed it could be anywhere
+            if(!tick)
             {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Minutes = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_12_24 = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
-        }
-        else
-        {      
-            if(IS_24_HOUR(time_ds1302))
-            {            
-                if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
+                if(changed && phaseTrimmed)
                 {
-                    uint8_t hour = COMBINE(time_ds1302.H24.hourX10, time_ds1302.H24.hour);
-                    
-                    if(hour == 0)
-                    {
-                        hour = 23;
-                    }
-                    else
-                    {
-                        hour--;
-                    }
-                    
-                    time_ds1302.H24.hourX10 = GET_X10(hour);
-                    time_ds1302.H24.hour = GET_X1(hour);
-                    menuTimeout = MENU_TIMEOUT_MAX;
+                    lock_phase();
+                    pending.Led = TRUE;
                 }
-//                else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//                {
-//                     uint8_t hour = COMBINE(time_ds1302.H24.hourX10, time_ds1302.H24.hour);
-//                    
-//                    if(hour == 23)
-//                    {
-//                        hour = 0;
-//                    }
-//                    else
-//                    {
-//                        hour++;
-//                    }
-//                    
-//                    time_ds1302.H24.hourX10 = GET_X10(hour);
-//                    time_ds1302.H24.hour = GET_X1(hour);
-//                    menuTimeout = MENU_TIMEOUT_MAX;
-//                }
-            }
-            else
-            {            
-                if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-                {
-                    uint8_t hour = COMBINE(time_ds1302.H12.hourX10, time_ds1302.H12.hour);
-                    
-                    if(hour == 1)
-                    {
-                        hour = 12;
-                    }
-                    else
-                    {
-                        hour--;
-                    }
-                    
-                    time_ds1302.H12.hourX10 = GET_X10(hour);
-                    time_ds1302.H12.hour = GET_X1(hour);
-                    menuTimeout = MENU_TIMEOUT_MAX;
-                }
-//                else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//                {
-//                    uint8_t hour = COMBINE(time_ds1302.H24.hourX10, time_ds1302.H24.hour);
-//                    
-//                    if(hour == 12)
-//                    {
-//                        hour = 1;
-//                    }
-//                    else
-//                    {
-//                        hour++;
-//                    }
-//                    
-//                    time_ds1302.H24.hourX10 = GET_X10(hour);
-//                    time_ds1302.H24.hour = GET_X1(hour);
-//                    menuTimeout = MENU_TIMEOUT_MAX;
-//                }
+                else if(changed)
+                    hunt_phase();
             }
+            else if(!changed)
+                hunt_phase();
+            
+            phaseCheck = FALSE;
         }
-    }
-    else if(menu.Menu_Data.edit_12_24)
-    {
-        if(menu.Menu_Data.selecting == FALSE)
+        else if(tick && changed)
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Hours = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Weekday = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            //Free running, hunt again as soon as the clock is seen moving
+            hunt_phase();
         }
-        else
+
+        //If seconds have reset read all data
+        //Going backwards without passing 0 means the loop was held over a rollover
+        if(changed && (*time_ptr == 0x00 || *time_ptr < lastSecond))
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat) ||
-                    PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-            {
-                time_ds1302.H24.hour_12_24 = ~time_ds1302.H24.hour_12_24;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }            
+            uint8_t skipped = (*time_ptr != 0x00);
+            
+            read_time_rtc(time_ptr);
+            
+            if(skipped)
+                log_event(EVENT_SYNC_SKIPPED, get_minute_of_week());
+            
+            roll_minute();
         }
+        pending.Time = FALSE;  
     }
-    else if(menu.Menu_Data.edit_Weekday)
+    else if(menu.Menu_State.enabled && phaseState == PHASE_COASTING)
     {
-        if(menu.Menu_Data.selecting == FALSE)
-        {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_12_24 = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Date = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
-        }
+        //Ticks are not counted while the menu is open
+        hunt_phase();
+    }
+
+    set_clock_digits();
+}
+
+//Store last input value and get new value
+//Debounce done on PCB
+void update_input(void)
+{
+    buttons.Center_Button_Old = buttons.Center_Button_Stat;    
+    buttons.Center_Button_Stat = (CENTER_BUTTON_PIN & (1 << CENTER_BUTTON)) ? 1 : 0;
+    
+    buttons.Left_Button_Old = buttons.Left_Button_Stat;
+    buttons.Left_Button_Stat = (LEFT_BUTTON_PIN & (1 << LEFT_BUTTON)) ? 1 : 0;
+    
+    buttons.Right_Button_Old = buttons.Right_Button_Stat;
+    buttons.Right_Button_Stat = (RIGHT_BUTTON_PIN & (1 << RIGHT_BUTTON)) ? 1 : 0;
+}
+
+//Work out the step for the held button, -1 left, +1 center
+//A press steps once, holding repeats and speeds up
+//Timed from the input tick so loop speed does not matter
+int8_t update_repeat(void)
+{
+    int8_t direction = 0;
+    uint8_t now = inputTicks;
+    
+    if(buttons.Left_Button_Stat == LOW)
+        direction = -1;
+    else if(buttons.Center_Button_Stat == LOW)
+        direction = 1;
+    
+    //Pressed, released or swapped buttons
+    if(direction != repeatDirection)
+    {
+        repeatDirection = direction;
+        repeatCount = 0;
+        repeatTime = now + REPEAT_DELAY;
+        return direction;
+    }
+    
+    if(direction == 0 || (int8_t)(now - repeatTime) < 0)
+        return 0;
+    
+    if(repeatCount < REPEAT_COARSE_COUNT)
+        repeatCount++;
+    
+    if(repeatCount <= REPEAT_SLOW_COUNT)
+        repeatTime = now + REPEAT_SLOW;
+    else if(repeatCount < REPEAT_COARSE_COUNT)
+        repeatTime = now + REPEAT_FAST;
+    else
+    {
+        repeatTime = now + REPEAT_COARSE;
+        return direction * REPEAT_COARSE_STEP;
+    }
+    
+    return direction;
+}
+
+//Move value by step between min and max, wrapping past either end
+uint8_t step_value(uint8_t value, int8_t step, uint8_t min, uint8_t max)
+{
+    //Garbage from an RTC that lost its backup restarts at min
+    if(value < min || value > max)
+        return min;
+    
+    int16_t next = (int16_t)value + step;
+    
+    if(next > max)
+        next -= max - min + 1;
+    else if(next < min)
+        next += max - min + 1;
+    
+    return next;
+}
+
+//Select the previous or next field, skipping the unused bit
+void move_menu(int8_t direction)
+{
+    uint8_t field = menu.Menu_State.enabled;
+    
+    do
+    {
+        if(direction < 0)
+            field = (field == MENU_FIRST_FIELD) ? MENU_LAST_FIELD : field >> 1;
         else
+            field = (field == MENU_LAST_FIELD) ? MENU_FIRST_FIELD : field << 1;
+    } while(field == MENU_RESERVED_FIELD);
+    
+    menu.Menu_State.enabled = field;
+    menuTimeout = MENU_TIMEOUT_MAX;
+}
+
+//Stopwatch from 0, countdown from the preset
+void reset_timer(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        timerRunning = FALSE;
+        timerHundredths = 0;
+        timerSeconds = (timerMode == TIMER_COUNTDOWN) ? timerPreset : 0;
+    }
+    
+    pending.Led = TRUE;
+}
+
+//Center starts and stops, right moves on to the countdown then back to the clock
+//Stopped, left clears the stopwatch or steps the countdown start down
+void update_timer(int8_t step)
+{
+    if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
+    {
+        timerMode = (timerMode == TIMER_STOPWATCH) ? TIMER_COUNTDOWN : TIMER_OFF;
+        reset_timer();
+        return;
+    }
+    
+    if(PRESSED(buttons.Center_Button_Old, buttons.Center_Button_Stat))
+    {
+        //Start a finished countdown again from the top
+        if(timerMode == TIMER_COUNTDOWN && !timerRunning && timerSeconds == 0 && timerHundredths == 0)
+            reset_timer();
+        
+        timerRunning = !timerRunning;
+        return;
+    }
+    
+    if(timerRunning)
+        return;
+    
+    if(timerMode == TIMER_STOPWATCH)
+    {
+        if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
+            reset_timer();
+    }
+    else if(step < 0)
+    {
+        timerPreset = step_value(timerPreset, step, 1, 99);
+        reset_timer();
+    }
+}
+
+void update_menu(void)
+{
+    int8_t step = update_repeat();
+    
+    //Any button silences a ringing alarm without opening the menu
+    if(alarmRinging)
+    {
+        if(PRESSED(buttons.Center_Button_Old, buttons.Center_Button_Stat) ||
+                PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat) || 
+                PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                if(time_ds1302.day == 1)
-                    time_ds1302.day = 7;
-                else
-                    time_ds1302.day--;
-                
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                if(time_ds1302.day == 7)
-//                    time_ds1302.day = 1;
-//                else
-//                    time_ds1302.day++;
-//                
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            alarmRinging = 0;
         }
+        
+        return;
     }
-    else if(menu.Menu_Data.edit_Date)
+    
+    if(timerMode != TIMER_OFF)
     {
-        if(menu.Menu_Data.selecting == FALSE)
+        update_timer(step);
+        return;
+    }
+    
+    //If the menu is not currently enabled
+    if(menu.Menu_State.enabled == FALSE)
+    {
+        //Center goes to the stopwatch
+        if(PRESSED(buttons.Center_Button_Old, buttons.Center_Button_Stat))
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Weekday = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Month = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            timerMode = TIMER_STOPWATCH;
+            reset_timer();
         }
-        else
+        //Left or right opens the menu
+        else if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat) || 
+                PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                uint8_t date = COMBINE(time_ds1302.dateX10, time_ds1302.date);
-                
-                if(date == 1)
-                    date = 31;
-                else 
-                    date--;
-                
-                time_ds1302.dateX10 = GET_X10(date);
-                time_ds1302.date = GET_X1(date);
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                uint8_t date = COMBINE(time_ds1302.dateX10, time_ds1302.date);
-//                
-//                if(date == 31)
-//                    date = 1;
-//                else
-//                    date++;
-//                
-//                time_ds1302.dateX10 = GET_X10(date);
-//                time_ds1302.date = GET_X1(date);
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            menu.Menu_State.enabled = 0x00;
+            menu.Menu_State.setting = 0x00;
+            menu.Menu_Data.edit_Minutes = TRUE;
+            
+            menuTimeout = MENU_TIMEOUT_MAX;
+            
+            //Stop clock
+            queue_halt_rtc();
+            commit_rtc();
         }
+        
+        return;
     }
-    else if(menu.Menu_Data.edit_Month)
+    else
+    {
+        if(menuTimeout == 0)
+        {
+            menu.Menu_State.enabled = 0x00;
+            menu.Menu_Data.selecting = FALSE;
+            save_time();
+            return;
+        }
+        
+        //Exactly one field is edited, anything else goes back to minutes
+        uint8_t field = menu.Menu_State.enabled;
+        
+        if((field & (field - 1)) || field == MENU_RESERVED_FIELD)
+            menu.Menu_State.enabled = MENU_FIRST_FIELD;
+    }
+    
+    if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
     {
         if(menu.Menu_Data.selecting == FALSE)
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Date = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Year = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            menu.Menu_Data.selecting = TRUE;
+            menuTimeout = MENU_TIMEOUT_MAX;
         }
         else
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                uint8_t month = COMBINE(time_ds1302.monthX10, time_ds1302.month);
-                
-                if(month == 1)
-                    month = 12;
-                else
-                    month--;
-                
-                time_ds1302.monthX10 = GET_X10(month);
-                time_ds1302.month = GET_X1(month);
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                uint8_t month = COMBINE(time_ds1302.monthX10, time_ds1302.month);
-//                
-//                if(month == 12)
-//                    month = 1;
-//                else
-//                    month++;
-//                
-//                time_ds1302.monthX10 = GET_X10(month);
-//                time_ds1302.month = GET_X1(month);
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            menu.Menu_State.enabled = 0x00;
+            menu.Menu_Data.selecting = FALSE;
+            menuTimeout = 0;
+            save_time();
+            return;
         }
     }
-    else if(menu.Menu_Data.edit_Year)
+    
+    //Left and center walk through the fields
+    if(menu.Menu_Data.selecting == FALSE)
     {
-        if(menu.Menu_Data.selecting == FALSE)
+        if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
+            move_menu(-1);
+        else if(PRESSED(buttons.Center_Button_Old, buttons.Center_Button_Stat))
+            move_menu(1);
+        
+        return;
+    }
+    
+    //Left and center step the selected field down and up
+    if(step == 0)
+        return;
+    
+    menuTimeout = MENU_TIMEOUT_MAX;
+    
+    if(menu.Menu_Data.edit_Minutes)
+    {
+        uint8_t mins = step_value(COMBINE(TIME(MINUTES_X10), TIME(MINUTES)), step, 0, 59);
+        
+        SET_TIME(MINUTES_X10, GET_X10(mins));
+        SET_TIME(MINUTES, GET_X1(mins));
+    }
+    else if(menu.Menu_Data.edit_Hours)
+    {
+        if(IS_24_HOUR(time_ds1302))
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                menu.Menu_State.enabled = 0x00;
-                menu.Menu_Data.edit_Month = TRUE;
-                menuTimeout = MENU_TIMEOUT_MAX;
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                menu.Menu_State.enabled = 0x00;
-//                menu.Menu_Data.edit_Minutes = TRUE;
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            uint8_t hour = step_value(COMBINE(TIME(HOUR24_X10), TIME(HOUR)), step, 0, 23);
+            
+            SET_TIME(HOUR24_X10, GET_X10(hour));
+            SET_TIME(HOUR, GET_X1(hour));
         }
         else
         {
-            if(PRESSED(buttons.Left_Button_Old, buttons.Left_Button_Stat))
-            {
-                uint8_t year = COMBINE(time_ds1302.yearX10, time_ds1302.year);
-                
-                if(year == 0)
-                    year = 99;
-                else
-                    year--;
-                
-                time_ds1302.yearX10 = GET_X10(year);
-                time_ds1302.year = GET_X1(year);
-                menuTimeout = MENU_TIMEOUT_MAX;
-                
-            }
-//            else if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
-//            {
-//                uint8_t year = COMBINE(time_ds1302.yearX10, time_ds1302.year);
-//                
-//                if(year == 99)
-//                    year = 0;
-//                else
-//                    year++;
-//                
-//                time_ds1302.yearX10 = GET_X10(year);
-//                time_ds1302.year = GET_X1(year);
-//                menuTimeout = MENU_TIMEOUT_MAX;
-//            }
+            uint8_t hour = step_value(COMBINE(TIME(HOUR12_X10), TIME(HOUR)), step, 1, 12);
+            
+            SET_TIME(HOUR12_X10, GET_X10(hour));
+            SET_TIME(HOUR, GET_X1(hour));
         }
     }
+    else if(menu.Menu_Data.edit_12_24)
+    {
+        //Hour bits mean different things in each mode, carry the hour over
+        //Garbage restarts at midnight as it would in step_value
+        uint8_t hour = get_hour_24();
+        
+        TOGGLE_TIME(HOUR_MODE);
+        set_hour_24((hour < 24) ? hour : 0);
+    }
+    else if(menu.Menu_Data.edit_Date)
+    {
+        uint8_t days = calendar_days_in_month(COMBINE(TIME(YEAR_X10), TIME(YEAR)),
+                COMBINE(TIME(MONTH_X10), TIME(MONTH)));
+        uint8_t date = step_value(COMBINE(TIME(DATE_X10), TIME(DATE)), step, 1, days);
+        
+        SET_TIME(DATE_X10, GET_X10(date));
+        SET_TIME(DATE, GET_X1(date));
+    }
+    else if(menu.Menu_Data.edit_Month)
+    {
+        uint8_t month = step_value(COMBINE(TIME(MONTH_X10), TIME(MONTH)), step, 1, 12);
+        
+        SET_TIME(MONTH_X10, GET_X10(month));
+        SET_TIME(MONTH, GET_X1(month));
+    }
+    else if(menu.Menu_Data.edit_Year)
+    {
+        uint8_t year = step_value(COMBINE(TIME(YEAR_X10), TIME(YEAR)), step, 0, 99);
+        
+        SET_TIME(YEAR_X10, GET_X10(year));
+        SET_TIME(YEAR, GET_X1(year));
+    }
+}
+
+//Supply lost, blank everything and sleep until it comes back
+void power_fail(void)
+{
+    //Disconnect PWM and hold output enable HIGH, clear the 595s
+    TCCR0A &= ~(1 << COM0A1);
+    DIGIT_OUTPUT_PORT |= (1 << DIGIT_OUTPUT);
+    DIGIT_CLEAR_PORT &= ~(1 << DIGIT_CLEAR);
+    
+    //Bus is only used from the main loop so no transfer is in flight
+    //DS1302 runs down to 2V, a DS1307 takes writes until VCC falls
+    //under 1.25 x VBAT, both well under POWER_LOW_MV so the record still makes it
+    log_event(EVENT_POWER_LOST, get_minute_of_week());
+    flush_rtc();
+    release_rtc_pins();
+    
+    power_down_until_restored();
+    
+    init_rtc_pins();
+    DIGIT_CLEAR_PORT |= (1 << DIGIT_CLEAR);
+    TCCR0A |= (1 << COM0A1);
+    
+    //Time moved on while asleep
+    read_time_rtc(time_ds1302);
+    sync_dst();
+    alarm_sync(get_minute_of_week());
+    unlock_phase();
+    
+    //595s were cleared so redraw
+    display_invalidate();
+    set_clock_digits();
+    pending.Led = TRUE;
+    
+    //Power down used the watchdog to wake and left it off
+    watchdog_start(TASK_ALL);
+}
+
+//Queue the warm restart state, only changed bytes are written
+void save_state(void)
+{
+    warmState[WARM_MENU] = menu.Menu_Raw;
+    warmState[WARM_BRIGHTNESS] = brightnessFilter >> BRIGHTNESS_FILTER_SHIFT;
+    warmState[WARM_TIMER_MODE] = timerMode;
+    warmState[WARM_TIMER_PRESET] = timerPreset;
+    
+    watchdog_save(warmState);
+}
+
+//Carry on after a watchdog reset as if the loop never stopped
+//Field checks in update_menu catch a corrupt menu byte
+void restore_state(void)
+{
+    menu.Menu_Raw = warmState[WARM_MENU];
+    
+    if(menu.Menu_State.enabled)
+        menuTimeout = MENU_TIMEOUT_MAX;
+    
+    //Straight to the last brightness instead of ramping from the middle
+    brightnessFilter = warmState[WARM_BRIGHTNESS] << BRIGHTNESS_FILTER_SHIFT;
+    brightnessDuty = pgm_read_word(&brightness_curve[warmState[WARM_BRIGHTNESS]]);
+    brightnessTarget = brightnessDuty;
+    
+    if(warmState[WARM_TIMER_MODE] <= TIMER_COUNTDOWN)
+        timerMode = warmState[WARM_TIMER_MODE];
+    
+    if(warmState[WARM_TIMER_PRESET] >= 1 && warmState[WARM_TIMER_PRESET] <= 99)
+        timerPreset = warmState[WARM_TIMER_PRESET];
+    
+    reset_timer();
 }
 
 int main(void) {
     
-    DDRA = 0b10010111;
-    DDRB = 0b00001111;
+    BENCH_BEGIN(BENCH_BOOT);
+    
+    DDRA = BOARD_OUTPUTS(A);
+    DDRB = BOARD_OUTPUTS(B);
+    
+    DIGIT_CLEAR_PORT |= (1 << DIGIT_CLEAR);
+    
+    //First frame before anything else, output enable is already LOW
+    //One RAM burst, one clock burst and one shift of the chain
+    init_display();
+    init_rtc_pins();
     
-    PORTA &= ~((1 << DIGIT_DATA) | (1 << DIGIT_LATCH) | (1 << DIGIT_CLOCK));
-    PORTA |= (1 << DIGIT_CLEAR);
+    uint8_t ram[BOOT_RAM_SIZE];
+    read_ram_rtc(0, ram, sizeof(ram));
+    
+    //Clock halted by the menu still holds the time, only a lost marker
+    //or registers out of range mean it has to be set again
+    uint8_t clockValid = (ram[CLOCK_RAM_INDEX] == CLOCK_MARKER) && init_rtc(time_ds1302);
+    
+    //Saved state is taken either way so later saves only write changes
+    if(watchdog_restore(ram, warmState) && watchdog_was_reset())
+    {
+        BENCH_END(BENCH_HANG);
+        restore_state();
+    }
+    
+    //Halted with the menu gone, start it again from where it stopped
+    if(clockValid && TIME(CLOCK_HALT) && !menu.Menu_State.enabled)
+    {
+        SET_TIME(CLOCK_HALT, 0);
+        queue_time_rtc(time_ds1302);
+    }
+    
+    set_clock_digits();
+    display_flush();
+    BENCH_END(BENCH_BOOT);
     
     //Initialisation
     init_adc();
     init_pwm();
     init_timer1();
-    init_ds1302((uint8_t*)&time_ds1302);
-
-    set_clock_digits();
     
+    //Start from the period learned for this temperature
+    init_tempcomp();
+    temperature = tempcomp_read();
+    
+    if(tempcomp_offset(temperature) != TEMPCOMP_UNKNOWN)
+        phaseOffset = tempcomp_offset(temperature);
+    
+    set_tick_period();
+    
+    //Backup supply was lost, start from the compiled in time
+    if(!clockValid)
+    {
+        validate_date();
+        queue_time_rtc(time_ds1302);
+        queue_ram_rtc(CLOCK_RAM_INDEX, CLOCK_MARKER);
+    }
+    
+    //Only costs a write if the backup charger setting changed
+    set_backup_rtc(time_ds1302[DS1302_IMAGE_TRICKLE_CHARGE]);
+    
+    //Boot record goes out with the daylight saving commit, and is flushed
+    //if there was nothing to commit so a reset loop still leaves a trail
+    init_event_log();
+    log_event(EVENT_BOOT, get_minute_of_week());
+    sync_dst();
+    flush_rtc();
+    
+    init_alarms();
+    alarm_sync(get_minute_of_week());
+    
+    //A provisioning jig holds left and right LOW through reset
+    if(bit_is_clear(LEFT_BUTTON_PIN, LEFT_BUTTON) && bit_is_clear(RIGHT_BUTTON_PIN, RIGHT_BUTTON))
+    {
+        serialMode = TRUE;
+        
+        //Wait for the jig to release the lines before listening
+        loop_until_bit_is_set(RIGHT_BUTTON_PIN, RIGHT_BUTTON);
+        init_serial();
+    }
+    
+    //Everything above runs once, supervise the loop from here on
+    watchdog_start(TASK_ALL);
     sei();
 
     while (1) 
     {      
         start_adc();       
        
-        update_input();
+        if(serialMode)
+        {
+            uint8_t changed = protocol_poll();
+            
+            //Clock, RTC RAM or alarms changed under us, reload and resync
+            if(changed)
+            {
+                read_time_rtc(time_ds1302);
+                
+                //Host may have rewritten the log head or the warm state,
+                //sync_dst below reads the DST flag again
+                if(changed & PROTOCOL_CHANGED_RAM)
+                {
+                    uint8_t ram[WATCHDOG_RAM_END];
+                    uint8_t stored[WATCHDOG_STATE_SIZE];
+                    
+                    init_event_log();
+                    read_ram_rtc(0, ram, sizeof(ram));
+                    watchdog_restore(ram, stored);
+                }
+                
+                if(changed & PROTOCOL_CHANGED_CLOCK)
+                {
+                    log_event(EVENT_TIME_EDITED, get_minute_of_week());
+                    unlock_phase();
+                }
+                
+                sync_dst();
+                alarm_sync(get_minute_of_week());
+            }
+        }
+        else
+        {
+            update_input();
+
+            BENCH_BEGIN(BENCH_UPDATE_MENU);
+            update_menu();
+            BENCH_END(BENCH_UPDATE_MENU);
+        }
         
-        update_menu();
+        watchdog_checkin(TASK_INPUT);
         
+        BENCH_BEGIN(BENCH_UPDATE_TIME);
         update_time();        
+        BENCH_END(BENCH_UPDATE_TIME);
+        watchdog_checkin(TASK_TIME);
         
+        BENCH_BEGIN(BENCH_RENDER);
         render();
+        BENCH_END(BENCH_RENDER);
+        watchdog_checkin(TASK_RENDER);
         
-        set_pwm_duty(read_ADC());     
+        //Conversion wait is not part of the benchmark
+        uint8_t adc = read_ADC();
+        BENCH_BEGIN(BENCH_BRIGHTNESS);
+        set_pwm_duty(get_brightness(adc));     
+        BENCH_END(BENCH_BRIGHTNESS);
+        watchdog_checkin(TASK_BRIGHTNESS);
+        
+        //ADC is idle here so the supply can be checked
+        if(pending.Power)
+        {
+            pending.Power = FALSE;
+            watchdog_checkin(TASK_TICK);
+            
+            if(power_is_low())
+                power_fail();
+            else if(++temperatureTicks >= PHASE_TEMPERATURE_TICKS)
+            {
+                temperatureTicks = 0;
+                update_temperature();
+            }
+            
+            //Only writes once something changed
+            save_state();
+            commit_rtc();
+            
+#ifdef FAULT_INJECT
+            if(++faultTicks >= FAULT_INJECT)
+            {
+                //Hang with interrupts still running, like a stuck conversion
+                BENCH_BEGIN(BENCH_HANG);
+                for(;;);
+            }
+#endif
+        }
     }
 }
\ No newline at end of file
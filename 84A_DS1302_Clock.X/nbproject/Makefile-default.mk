@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=DS1302.c main.c
+SOURCEFILES_QUOTED_IF_SPACED=DS1302.c DS1307.c UsiTwi.c Watchdog.c SimTrace.c TempComp.c EventLog.c Power.c Protocol.c Serial.c Dst.c Calendar.c Alarm.c Display.c main.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/DS1302.o ${OBJECTDIR}/main.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/DS1302.o.d ${OBJECTDIR}/main.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/DS1302.o ${OBJECTDIR}/DS1307.o ${OBJECTDIR}/UsiTwi.o ${OBJECTDIR}/Watchdog.o ${OBJECTDIR}/SimTrace.o ${OBJECTDIR}/TempComp.o ${OBJECTDIR}/EventLog.o ${OBJECTDIR}/Power.o ${OBJECTDIR}/Protocol.o ${OBJECTDIR}/Serial.o ${OBJECTDIR}/Dst.o ${OBJECTDIR}/Calendar.o ${OBJECTDIR}/Alarm.o ${OBJECTDIR}/Display.o ${OBJECTDIR}/main.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/DS1302.o.d ${OBJECTDIR}/DS1307.o.d ${OBJECTDIR}/UsiTwi.o.d ${OBJECTDIR}/Watchdog.o.d ${OBJECTDIR}/SimTrace.o.d ${OBJECTDIR}/TempComp.o.d ${OBJECTDIR}/EventLog.o.d ${OBJECTDIR}/Power.o.d ${OBJECTDIR}/Protocol.o.d ${OBJECTDIR}/Serial.o.d ${OBJECTDIR}/Dst.o.d ${OBJECTDIR}/Calendar.o.d ${OBJECTDIR}/Alarm.o.d ${OBJECTDIR}/Display.o.d ${OBJECTDIR}/main.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/DS1302.o ${OBJECTDIR}/main.o
+OBJECTFILES=${OBJECTDIR}/DS1302.o ${OBJECTDIR}/DS1307.o ${OBJECTDIR}/UsiTwi.o ${OBJECTDIR}/Watchdog.o ${OBJECTDIR}/SimTrace.o ${OBJECTDIR}/TempComp.o ${OBJECTDIR}/EventLog.o ${OBJECTDIR}/Power.o ${OBJECTDIR}/Protocol.o ${OBJECTDIR}/Serial.o ${OBJECTDIR}/Dst.o ${OBJECTDIR}/Calendar.o ${OBJECTDIR}/Alarm.o ${OBJECTDIR}/Display.o ${OBJECTDIR}/main.o
 
 # Source Files
-SOURCEFILES=DS1302.c main.c
+SOURCEFILES=DS1302.c DS1307.c UsiTwi.c Watchdog.c SimTrace.c TempComp.c EventLog.c Power.c Protocol.c Serial.c Dst.c Calendar.c Alarm.c Display.c main.c
 
 
 
@@ -100,6 +100,84 @@ ${OBJECTDIR}/DS1302.o: DS1302.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/DS1302.o 
 	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/DS1302.o.d" -MT "${OBJECTDIR}/DS1302.o.d" -MT ${OBJECTDIR}/DS1302.o -o ${OBJECTDIR}/DS1302.o DS1302.c 
 	
+${OBJECTDIR}/DS1307.o: DS1307.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DS1307.o.d 
+	@${RM} ${OBJECTDIR}/DS1307.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/DS1307.o.d" -MT "${OBJECTDIR}/DS1307.o.d" -MT ${OBJECTDIR}/DS1307.o -o ${OBJECTDIR}/DS1307.o DS1307.c 
+	
+${OBJECTDIR}/UsiTwi.o: UsiTwi.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/UsiTwi.o.d 
+	@${RM} ${OBJECTDIR}/UsiTwi.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/UsiTwi.o.d" -MT "${OBJECTDIR}/UsiTwi.o.d" -MT ${OBJECTDIR}/UsiTwi.o -o ${OBJECTDIR}/UsiTwi.o UsiTwi.c 
+	
+${OBJECTDIR}/Watchdog.o: Watchdog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Watchdog.o.d 
+	@${RM} ${OBJECTDIR}/Watchdog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Watchdog.o.d" -MT "${OBJECTDIR}/Watchdog.o.d" -MT ${OBJECTDIR}/Watchdog.o -o ${OBJECTDIR}/Watchdog.o Watchdog.c 
+	
+${OBJECTDIR}/SimTrace.o: SimTrace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SimTrace.o.d 
+	@${RM} ${OBJECTDIR}/SimTrace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/SimTrace.o.d" -MT "${OBJECTDIR}/SimTrace.o.d" -MT ${OBJECTDIR}/SimTrace.o -o ${OBJECTDIR}/SimTrace.o SimTrace.c 
+	
+${OBJECTDIR}/TempComp.o: TempComp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TempComp.o.d 
+	@${RM} ${OBJECTDIR}/TempComp.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/TempComp.o.d" -MT "${OBJECTDIR}/TempComp.o.d" -MT ${OBJECTDIR}/TempComp.o -o ${OBJECTDIR}/TempComp.o TempComp.c 
+	
+${OBJECTDIR}/EventLog.o: EventLog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLog.o.d 
+	@${RM} ${OBJECTDIR}/EventLog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/EventLog.o.d" -MT "${OBJECTDIR}/EventLog.o.d" -MT ${OBJECTDIR}/EventLog.o -o ${OBJECTDIR}/EventLog.o EventLog.c 
+	
+${OBJECTDIR}/Power.o: Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Power.o.d 
+	@${RM} ${OBJECTDIR}/Power.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Power.o.d" -MT "${OBJECTDIR}/Power.o.d" -MT ${OBJECTDIR}/Power.o -o ${OBJECTDIR}/Power.o Power.c 
+	
+${OBJECTDIR}/Protocol.o: Protocol.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Protocol.o.d 
+	@${RM} ${OBJECTDIR}/Protocol.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Protocol.o.d" -MT "${OBJECTDIR}/Protocol.o.d" -MT ${OBJECTDIR}/Protocol.o -o ${OBJECTDIR}/Protocol.o Protocol.c 
+	
+${OBJECTDIR}/Serial.o: Serial.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Serial.o.d 
+	@${RM} ${OBJECTDIR}/Serial.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Serial.o.d" -MT "${OBJECTDIR}/Serial.o.d" -MT ${OBJECTDIR}/Serial.o -o ${OBJECTDIR}/Serial.o Serial.c 
+	
+${OBJECTDIR}/Dst.o: Dst.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Dst.o.d 
+	@${RM} ${OBJECTDIR}/Dst.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Dst.o.d" -MT "${OBJECTDIR}/Dst.o.d" -MT ${OBJECTDIR}/Dst.o -o ${OBJECTDIR}/Dst.o Dst.c 
+	
+${OBJECTDIR}/Calendar.o: Calendar.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Calendar.o.d 
+	@${RM} ${OBJECTDIR}/Calendar.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Calendar.o.d" -MT "${OBJECTDIR}/Calendar.o.d" -MT ${OBJECTDIR}/Calendar.o -o ${OBJECTDIR}/Calendar.o Calendar.c 
+	
+${OBJECTDIR}/Alarm.o: Alarm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Alarm.o.d 
+	@${RM} ${OBJECTDIR}/Alarm.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Alarm.o.d" -MT "${OBJECTDIR}/Alarm.o.d" -MT ${OBJECTDIR}/Alarm.o -o ${OBJECTDIR}/Alarm.o Alarm.c 
+	
+${OBJECTDIR}/Display.o: Display.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Display.o.d 
+	@${RM} ${OBJECTDIR}/Display.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Display.o.d" -MT "${OBJECTDIR}/Display.o.d" -MT ${OBJECTDIR}/Display.o -o ${OBJECTDIR}/Display.o Display.c 
+	
 ${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/main.o.d 
@@ -113,6 +191,84 @@ ${OBJECTDIR}/DS1302.o: DS1302.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/DS1302.o 
 	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/DS1302.o.d" -MT "${OBJECTDIR}/DS1302.o.d" -MT ${OBJECTDIR}/DS1302.o -o ${OBJECTDIR}/DS1302.o DS1302.c 
 	
+${OBJECTDIR}/DS1307.o: DS1307.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DS1307.o.d 
+	@${RM} ${OBJECTDIR}/DS1307.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/DS1307.o.d" -MT "${OBJECTDIR}/DS1307.o.d" -MT ${OBJECTDIR}/DS1307.o -o ${OBJECTDIR}/DS1307.o DS1307.c 
+	
+${OBJECTDIR}/UsiTwi.o: UsiTwi.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/UsiTwi.o.d 
+	@${RM} ${OBJECTDIR}/UsiTwi.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/UsiTwi.o.d" -MT "${OBJECTDIR}/UsiTwi.o.d" -MT ${OBJECTDIR}/UsiTwi.o -o ${OBJECTDIR}/UsiTwi.o UsiTwi.c 
+	
+${OBJECTDIR}/Watchdog.o: Watchdog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Watchdog.o.d 
+	@${RM} ${OBJECTDIR}/Watchdog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Watchdog.o.d" -MT "${OBJECTDIR}/Watchdog.o.d" -MT ${OBJECTDIR}/Watchdog.o -o ${OBJECTDIR}/Watchdog.o Watchdog.c 
+	
+${OBJECTDIR}/SimTrace.o: SimTrace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SimTrace.o.d 
+	@${RM} ${OBJECTDIR}/SimTrace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/SimTrace.o.d" -MT "${OBJECTDIR}/SimTrace.o.d" -MT ${OBJECTDIR}/SimTrace.o -o ${OBJECTDIR}/SimTrace.o SimTrace.c 
+	
+${OBJECTDIR}/TempComp.o: TempComp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/TempComp.o.d 
+	@${RM} ${OBJECTDIR}/TempComp.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/TempComp.o.d" -MT "${OBJECTDIR}/TempComp.o.d" -MT ${OBJECTDIR}/TempComp.o -o ${OBJECTDIR}/TempComp.o TempComp.c 
+	
+${OBJECTDIR}/EventLog.o: EventLog.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EventLog.o.d 
+	@${RM} ${OBJECTDIR}/EventLog.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/EventLog.o.d" -MT "${OBJECTDIR}/EventLog.o.d" -MT ${OBJECTDIR}/EventLog.o -o ${OBJECTDIR}/EventLog.o EventLog.c 
+	
+${OBJECTDIR}/Power.o: Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Power.o.d 
+	@${RM} ${OBJECTDIR}/Power.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Power.o.d" -MT "${OBJECTDIR}/Power.o.d" -MT ${OBJECTDIR}/Power.o -o ${OBJECTDIR}/Power.o Power.c 
+	
+${OBJECTDIR}/Protocol.o: Protocol.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Protocol.o.d 
+	@${RM} ${OBJECTDIR}/Protocol.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Protocol.o.d" -MT "${OBJECTDIR}/Protocol.o.d" -MT ${OBJECTDIR}/Protocol.o -o ${OBJECTDIR}/Protocol.o Protocol.c 
+	
+${OBJECTDIR}/Serial.o: Serial.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Serial.o.d 
+	@${RM} ${OBJECTDIR}/Serial.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Serial.o.d" -MT "${OBJECTDIR}/Serial.o.d" -MT ${OBJECTDIR}/Serial.o -o ${OBJECTDIR}/Serial.o Serial.c 
+	
+${OBJECTDIR}/Dst.o: Dst.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Dst.o.d 
+	@${RM} ${OBJECTDIR}/Dst.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Dst.o.d" -MT "${OBJECTDIR}/Dst.o.d" -MT ${OBJECTDIR}/Dst.o -o ${OBJECTDIR}/Dst.o Dst.c 
+	
+${OBJECTDIR}/Calendar.o: Calendar.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Calendar.o.d 
+	@${RM} ${OBJECTDIR}/Calendar.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Calendar.o.d" -MT "${OBJECTDIR}/Calendar.o.d" -MT ${OBJECTDIR}/Calendar.o -o ${OBJECTDIR}/Calendar.o Calendar.c 
+	
+${OBJECTDIR}/Alarm.o: Alarm.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Alarm.o.d 
+	@${RM} ${OBJECTDIR}/Alarm.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Alarm.o.d" -MT "${OBJECTDIR}/Alarm.o.d" -MT ${OBJECTDIR}/Alarm.o -o ${OBJECTDIR}/Alarm.o Alarm.c 
+	
+${OBJECTDIR}/Display.o: Display.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Display.o.d 
+	@${RM} ${OBJECTDIR}/Display.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp=${DFP_DIR}  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fpack-struct -fshort-enums -funsigned-char -funsigned-bitfields -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3     -MD -MP -MF "${OBJECTDIR}/Display.o.d" -MT "${OBJECTDIR}/Display.o.d" -MT ${OBJECTDIR}/Display.o -o ${OBJECTDIR}/Display.o Display.c 
+	
 ${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/main.o.d 
@@ -0,0 +1,59 @@
+/*
+ * File:   check.h
+ * Author: TallDwarf
+ *
+ * Shared by the host tests. CHECK counts a check and prints the first
+ * CHECK_SHOWN failures, check_report prints the summary line
+ * A test that wants more printed on a failure defines CHECK_DETAIL()
+ * before including this
+ */
+
+#ifndef CHECK_H
+#define	CHECK_H
+
+#include <stdio.h>
+#include <stdarg.h>
+
+//Failures printed in full, the rest are only counted
+#define CHECK_SHOWN 10
+
+#ifndef CHECK_DETAIL
+#define CHECK_DETAIL()
+#endif
+
+static int failures;
+static long checks;
+
+#define CHECK(condition, ...) \
+    do { \
+        checks++; \
+        if(!(condition) && failures++ < CHECK_SHOWN) \
+        { \
+            printf(__VA_ARGS__); \
+            putchar('\n'); \
+            CHECK_DETAIL(); \
+        } \
+    } while(0)
+
+//Prints "name: details, N checks, N failures", details may be NULL
+//Returns the exit status for main
+static int check_report(const char* name, const char* format, ...)
+{
+    printf("%s: ", name);
+    
+    if(format)
+    {
+        va_list args;
+        
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        printf(", ");
+    }
+    
+    printf("%ld checks, %d failures\n", checks, failures);
+    
+    return failures != 0;
+}
+
+#endif	/* CHECK_H */
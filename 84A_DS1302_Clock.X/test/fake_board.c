@@ -0,0 +1,90 @@
+/*
+ * File:   fake_board.c
+ * Author: TallDwarf
+ *
+ * Do nothing stand ins for the modules main.c calls that only matter on
+ * the board: supply, serial port, sensor, watchdog and protocol
+ * The supply is always good and the temperature never learned
+ */
+
+#include "Power.h"
+#include "Serial.h"
+#include "TempComp.h"
+#include "Watchdog.h"
+#include "Protocol.h"
+
+uint8_t power_read_supply(void)
+{
+    return 0xFF;
+}
+
+uint8_t power_is_low(void)
+{
+    return 0;
+}
+
+void power_down_until_restored(void)
+{
+}
+
+void init_serial(void)
+{
+}
+
+void serial_write_byte(uint8_t data)
+{
+}
+
+void serial_reset(void)
+{
+}
+
+uint8_t protocol_poll(void)
+{
+    return 0;
+}
+
+void init_tempcomp(void)
+{
+}
+
+uint8_t tempcomp_read(void)
+{
+    return 0;
+}
+
+uint8_t tempcomp_bucket(uint8_t temperature)
+{
+    return 0;
+}
+
+int16_t tempcomp_offset(uint8_t temperature)
+{
+    return TEMPCOMP_UNKNOWN;
+}
+
+void tempcomp_learn(uint8_t temperature, int16_t offset)
+{
+}
+
+uint8_t watchdog_was_reset(void)
+{
+    return 0;
+}
+
+void watchdog_start(uint8_t tasks)
+{
+}
+
+void watchdog_checkin(uint8_t task)
+{
+}
+
+uint8_t watchdog_restore(const uint8_t* ram, uint8_t* state)
+{
+    return 0;
+}
+
+void watchdog_save(const uint8_t* state)
+{
+}
@@ -0,0 +1,131 @@
+/*
+ * File:   fake_rtc.c
+ * Author: TallDwarf
+ *
+ * DS1302 driver entry points over the FakeRtc registers. Queue rules match
+ * DS1302.c: a queued address is replaced, a full queue is sent first, the
+ * clock never splits across commits and deferred writes wait for a commit
+ * that sends something anyway
+ */
+
+#include <string.h>
+#include "fake_rtc.h"
+
+FakeRtc fakeRtc;
+
+//Register index of a clock address, RAM is handled apart
+static uint8_t* fake_register(uint8_t address)
+{
+    address &= ~(1 << DS1302_READBIT);
+
+    if(address >= DS1302_RAM_START)
+        return &fakeRtc.ram[(address - DS1302_RAM_START) >> 1];
+
+    return &fakeRtc.registers[(address - DS1302_SECOND) >> 1];
+}
+
+uint8_t init_ds1302(uint8_t* time)
+{
+    //Validity rules are DS1302.c's, the fake takes any clock
+    burst_read_from_ds1302(time);
+
+    return 1;
+}
+
+void init_ds1302_pins(void)
+{
+}
+
+void release_ds1302_pins(void)
+{
+}
+
+void burst_read_from_ds1302(uint8_t* ds1302_data)
+{
+    memcpy(ds1302_data, fakeRtc.registers, 8);
+    fakeRtc.transactions++;
+}
+
+void read_from_address_ds1302(uint8_t address, uint8_t* data)
+{
+    *data = *fake_register(address);
+    fakeRtc.transactions++;
+}
+
+void read_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count)
+{
+    memcpy(data, &fakeRtc.ram[index], count);
+    fakeRtc.transactions++;
+}
+
+void write_ram_ds1302(uint8_t index, uint8_t* data, uint8_t count)
+{
+    memcpy(&fakeRtc.ram[index], data, count);
+    fakeRtc.transactions++;
+}
+
+uint8_t set_trickle_charge_ds1302(uint8_t setting)
+{
+    if(fakeRtc.registers[DS1302_IMAGE_TRICKLE_CHARGE] != setting)
+        queue_write_ds1302(DS1302_TRICKLE_CHARGE, setting);
+
+    return 1;
+}
+
+void flush_ds1302(void)
+{
+    if(fakeRtc.queued == 0)
+        return;
+
+    for(uint8_t i = 0; i < fakeRtc.queued; ++i)
+        *fake_register(fakeRtc.queueAddress[i]) = fakeRtc.queueData[i];
+
+    fakeRtc.queued = 0;
+    fakeRtc.commitDue = 0;
+    fakeRtc.transactions++;
+}
+
+void commit_ds1302(void)
+{
+    if(fakeRtc.commitDue)
+        flush_ds1302();
+}
+
+static void queue_entry(uint8_t address, uint8_t data)
+{
+    for(uint8_t i = 0; i < fakeRtc.queued; ++i)
+    {
+        if(fakeRtc.queueAddress[i] == address)
+        {
+            fakeRtc.queueData[i] = data;
+            return;
+        }
+    }
+
+    if(fakeRtc.queued == DS1302_QUEUE_SIZE)
+        flush_ds1302();
+
+    fakeRtc.queueAddress[fakeRtc.queued] = address;
+    fakeRtc.queueData[fakeRtc.queued] = data;
+    fakeRtc.queued++;
+}
+
+void queue_write_ds1302(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+    fakeRtc.commitDue = 1;
+}
+
+void queue_deferred_ds1302(uint8_t address, uint8_t data)
+{
+    queue_entry(address, data);
+}
+
+void queue_clock_ds1302(uint8_t* time)
+{
+    if(fakeRtc.queued > DS1302_QUEUE_SIZE - 7)
+        flush_ds1302();
+
+    for(uint8_t address = DS1302_SECOND; address <= DS1302_YEAR; address += 2)
+        queue_write_ds1302(address, *time++);
+}
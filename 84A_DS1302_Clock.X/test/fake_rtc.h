@@ -0,0 +1,39 @@
+/*
+ * File:   fake_rtc.h
+ * Author: TallDwarf
+ *
+ * Register level stand in for the DS1302 driver. Registers and RAM are
+ * plain arrays, queued writes land on them at the commit that would have
+ * sent them. The whole chip is one struct so a test can save and restore it
+ */
+
+#ifndef FAKE_RTC_H
+#define	FAKE_RTC_H
+
+#include <stdint.h>
+#include "DS1302.h"
+
+//Clock registers 0x80 - 0x90 in address order, then RAM
+#define FAKE_RTC_REGISTERS DS1302_IMAGE_SIZE
+
+typedef struct
+{
+    uint8_t registers[FAKE_RTC_REGISTERS];
+    uint8_t ram[DS1302_RAM_SIZE];
+
+    //Writes waiting for a commit, the driver queue has the same limit
+    uint8_t queueAddress[DS1302_QUEUE_SIZE];
+    uint8_t queueData[DS1302_QUEUE_SIZE];
+    uint8_t queued;
+    uint8_t commitDue;
+
+    //Chip enable cycles, one per read or per commit that sent anything
+    unsigned long transactions;
+} FakeRtc;
+
+extern FakeRtc fakeRtc;
+
+//Clock running from the seconds register
+#define FAKE_RTC_HALTED() (fakeRtc.registers[DS1302_IMAGE_SECOND] & 0x80)
+
+#endif	/* FAKE_RTC_H */
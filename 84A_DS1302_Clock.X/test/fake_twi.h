@@ -0,0 +1,39 @@
+/*
+ * File:   fake_twi.h
+ * Author: TallDwarf
+ *
+ * Stand in for UsiTwi.c with a DS1307 on the other end of the bus
+ * Counters let a test see what a driver call put on the wire
+ */
+
+#ifndef FAKE_TWI_H
+#define	FAKE_TWI_H
+
+#include <stdint.h>
+#include "DS1307.h"
+
+//Clock, control and RAM, the register pointer wraps after the last
+#define FAKE_TWI_REGISTERS (DS1307_RAM_START + DS1307_RAM_SIZE)
+
+typedef struct
+{
+    uint8_t registers[FAKE_TWI_REGISTERS];
+    uint8_t pointer;
+    
+    //Chip answers its address
+    uint8_t present;
+    uint8_t reading;
+    //Next byte written sets the register pointer
+    uint8_t pointerDue;
+    
+    //Starts and repeated starts, stops, bytes on the wire with addresses,
+    //register bytes written
+    unsigned long starts;
+    unsigned long stops;
+    unsigned long bytes;
+    unsigned long written;
+} FakeTwi;
+
+extern FakeTwi fakeTwi;
+
+#endif	/* FAKE_TWI_H */
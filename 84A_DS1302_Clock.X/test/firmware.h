@@ -0,0 +1,19 @@
+/*
+ * File:   firmware.h
+ * Author: TallDwarf
+ *
+ * Builds main.c into a test that needs its statics. Its main is renamed
+ * to firmware_main so the test has its own, and the RTC calls land on
+ * test/fake_rtc.c
+ */
+
+#ifndef FIRMWARE_H
+#define	FIRMWARE_H
+
+#define main firmware_main
+#include "main.c"
+#undef main
+
+#include "fake_rtc.h"
+
+#endif	/* FIRMWARE_H */
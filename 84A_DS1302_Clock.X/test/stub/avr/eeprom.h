@@ -0,0 +1,23 @@
+/*
+ * File:   eeprom.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <avr/eeprom.h>, EEMEM variables live in RAM
+ */
+
+#ifndef HOST_AVR_EEPROM_H
+#define	HOST_AVR_EEPROM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define EEMEM
+
+uint8_t eeprom_read_byte(const uint8_t* address);
+uint16_t eeprom_read_word(const uint16_t* address);
+void eeprom_read_block(void* destination, const void* source, size_t size);
+void eeprom_update_byte(uint8_t* address, uint8_t value);
+void eeprom_update_word(uint16_t* address, uint16_t value);
+void eeprom_update_block(const void* source, void* destination, size_t size);
+
+#endif	/* HOST_AVR_EEPROM_H */
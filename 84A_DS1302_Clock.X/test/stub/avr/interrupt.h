@@ -0,0 +1,20 @@
+/*
+ * File:   interrupt.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <avr/interrupt.h>, an ISR is a plain function the
+ * test calls when its simulated event happens
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define	HOST_AVR_INTERRUPT_H
+
+#define ISR(vector, ...) void vector(void); void vector(void)
+#define EMPTY_INTERRUPT(vector) void vector(void); void vector(void) { }
+#define ISR_NOBLOCK
+#define ISR_NAKED
+
+#define sei()
+#define cli()
+
+#endif	/* HOST_AVR_INTERRUPT_H */
@@ -0,0 +1,182 @@
+/*
+ * File:   io.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <avr/io.h>, ATtiny84A registers become plain
+ * variables defined in avr_host.c so tests can drive pins and timers
+ */
+
+#ifndef HOST_AVR_IO_H
+#define	HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#define HOST_REGISTER(name) extern volatile uint8_t name;
+
+HOST_REGISTER(PORTA) HOST_REGISTER(DDRA) HOST_REGISTER(PINA)
+HOST_REGISTER(PORTB) HOST_REGISTER(DDRB) HOST_REGISTER(PINB)
+HOST_REGISTER(TCCR0A) HOST_REGISTER(TCCR0B) HOST_REGISTER(TCNT0)
+HOST_REGISTER(OCR0A) HOST_REGISTER(OCR0B) HOST_REGISTER(TIMSK0) HOST_REGISTER(TIFR0)
+HOST_REGISTER(TCCR1A) HOST_REGISTER(TCCR1B) HOST_REGISTER(TCCR1C)
+HOST_REGISTER(TIMSK1) HOST_REGISTER(TIFR1)
+HOST_REGISTER(ADMUX) HOST_REGISTER(ADCSRA) HOST_REGISTER(ADCSRB)
+HOST_REGISTER(ADCH) HOST_REGISTER(ADCL) HOST_REGISTER(DIDR0)
+HOST_REGISTER(ACSR) HOST_REGISTER(MCUSR) HOST_REGISTER(MCUCR) HOST_REGISTER(WDTCSR)
+HOST_REGISTER(PRR) HOST_REGISTER(GIMSK) HOST_REGISTER(GIFR)
+HOST_REGISTER(PCMSK0) HOST_REGISTER(PCMSK1)
+HOST_REGISTER(USICR) HOST_REGISTER(USISR) HOST_REGISTER(USIDR) HOST_REGISTER(USIBR)
+HOST_REGISTER(GPIOR0) HOST_REGISTER(GPIOR1) HOST_REGISTER(GPIOR2)
+HOST_REGISTER(EEARL) HOST_REGISTER(EEDR) HOST_REGISTER(EECR)
+HOST_REGISTER(OSCCAL) HOST_REGISTER(SREG)
+
+extern volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1, ADC, ADCW;
+
+#define PORTA0 0
+#define PORTA1 1
+#define PORTA2 2
+#define PORTA3 3
+#define PORTA4 4
+#define PORTA5 5
+#define PORTA6 6
+#define PORTA7 7
+#define PORTB0 0
+#define PORTB1 1
+#define PORTB2 2
+#define PORTB3 3
+#define PINA0 0
+#define PINA1 1
+#define PINA2 2
+#define PINA3 3
+#define PINA4 4
+#define PINA5 5
+#define PINA6 6
+#define PINA7 7
+#define PINB0 0
+#define PINB1 1
+#define PINB2 2
+#define PINB3 3
+#define DDA0 0
+#define DDA3 3
+#define DDB2 2
+
+#define CS00 0
+#define CS01 1
+#define CS02 2
+#define WGM00 0
+#define WGM01 1
+#define WGM02 3
+#define COM0A0 6
+#define COM0A1 7
+#define COM0B0 4
+#define COM0B1 5
+#define TOIE0 0
+#define OCIE0A 1
+#define OCIE0B 2
+#define TOV0 0
+#define OCF0A 1
+#define OCF0B 2
+
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM10 0
+#define WGM11 1
+#define WGM12 3
+#define WGM13 4
+#define COM1A0 6
+#define COM1A1 7
+#define COM1B0 4
+#define COM1B1 5
+#define TOIE1 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define TOV1 0
+#define OCF1A 1
+#define OCF1B 2
+
+#define MUX0 0
+#define MUX1 1
+#define MUX2 2
+#define MUX3 3
+#define MUX4 4
+#define MUX5 5
+#define REFS0 6
+#define REFS1 7
+#define ADPS0 0
+#define ADPS1 1
+#define ADPS2 2
+#define ADIE 3
+#define ADIF 4
+#define ADATE 5
+#define ADSC 6
+#define ADEN 7
+#define ADLAR 4
+#define BIN 7
+
+#define ACIE 3
+#define ACI 4
+#define ACO 5
+#define ACBG 6
+#define ACD 7
+
+#define PORF 0
+#define EXTRF 1
+#define BORF 2
+#define WDRF 3
+#define WDP0 0
+#define WDP1 1
+#define WDP2 2
+#define WDE 3
+#define WDCE 4
+#define WDP3 5
+#define WDIE 6
+#define WDIF 7
+
+#define PRADC 0
+#define PRUSI 1
+#define PRTIM0 2
+#define PRTIM1 3
+#define SM0 3
+#define SM1 4
+#define SE 5
+
+#define USITC 0
+#define USICLK 1
+#define USICS0 2
+#define USICS1 3
+#define USIWM0 4
+#define USIWM1 5
+#define USIOIE 6
+#define USISIE 7
+#define USICNT0 0
+#define USIDC 4
+#define USIPF 5
+#define USIOIF 6
+#define USISIF 7
+
+#define INT0 6
+#define PCIE0 4
+#define PCIE1 5
+#define PCIF0 4
+#define PCIF1 5
+#define PCINT0 0
+#define PCINT1 1
+#define PCINT2 2
+#define PCINT3 3
+#define PCINT4 4
+#define PCINT5 5
+#define PCINT6 6
+#define PCINT7 7
+#define PCINT8 0
+#define PCINT9 1
+#define PCINT10 2
+#define PCINT11 3
+
+#define _BV(bit) (1 << (bit))
+#define bit_is_set(reg, bit) ((reg) & _BV(bit))
+#define bit_is_clear(reg, bit) (!((reg) & _BV(bit)))
+#define loop_until_bit_is_set(reg, bit) do { } while(bit_is_clear(reg, bit))
+#define loop_until_bit_is_clear(reg, bit) do { } while(bit_is_set(reg, bit))
+#define _SFR_IO_ADDR(reg) 0
+
+#endif	/* HOST_AVR_IO_H */
@@ -0,0 +1,22 @@
+/*
+ * File:   sleep.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <avr/sleep.h>, sleeping returns at once
+ */
+
+#ifndef HOST_AVR_SLEEP_H
+#define	HOST_AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_ADC 1
+#define SLEEP_MODE_PWR_DOWN 2
+
+#define set_sleep_mode(mode)
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_cpu()
+#define sleep_mode()
+#define sleep_bod_disable()
+
+#endif	/* HOST_AVR_SLEEP_H */
@@ -0,0 +1,76 @@
+/*
+ * File:   avr_host.c
+ * Author: TallDwarf
+ *
+ * Register and library definitions behind the host stand in headers
+ * EEMEM is empty on the host so EEPROM addresses are ordinary pointers
+ */
+
+#include <string.h>
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+#include <util/delay.h>
+
+#undef HOST_REGISTER
+#define HOST_REGISTER(name) volatile uint8_t name;
+
+HOST_REGISTER(PORTA) HOST_REGISTER(DDRA) HOST_REGISTER(PINA)
+HOST_REGISTER(PORTB) HOST_REGISTER(DDRB) HOST_REGISTER(PINB)
+HOST_REGISTER(TCCR0A) HOST_REGISTER(TCCR0B) HOST_REGISTER(TCNT0)
+HOST_REGISTER(OCR0A) HOST_REGISTER(OCR0B) HOST_REGISTER(TIMSK0) HOST_REGISTER(TIFR0)
+HOST_REGISTER(TCCR1A) HOST_REGISTER(TCCR1B) HOST_REGISTER(TCCR1C)
+HOST_REGISTER(TIMSK1) HOST_REGISTER(TIFR1)
+HOST_REGISTER(ADMUX) HOST_REGISTER(ADCSRA) HOST_REGISTER(ADCSRB)
+HOST_REGISTER(ADCH) HOST_REGISTER(ADCL) HOST_REGISTER(DIDR0)
+HOST_REGISTER(ACSR) HOST_REGISTER(MCUSR) HOST_REGISTER(MCUCR) HOST_REGISTER(WDTCSR)
+HOST_REGISTER(PRR) HOST_REGISTER(GIMSK) HOST_REGISTER(GIFR)
+HOST_REGISTER(PCMSK0) HOST_REGISTER(PCMSK1)
+HOST_REGISTER(USICR) HOST_REGISTER(USISR) HOST_REGISTER(USIDR) HOST_REGISTER(USIBR)
+HOST_REGISTER(GPIOR0) HOST_REGISTER(GPIOR1) HOST_REGISTER(GPIOR2)
+HOST_REGISTER(EEARL) HOST_REGISTER(EEDR) HOST_REGISTER(EECR)
+HOST_REGISTER(OSCCAL) HOST_REGISTER(SREG)
+
+volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1, ADC, ADCW;
+
+unsigned long hostWatchdogKicks;
+double hostDelayMicroseconds;
+
+uint8_t eeprom_read_byte(const uint8_t* address)
+{
+    return *address;
+}
+
+uint16_t eeprom_read_word(const uint16_t* address)
+{
+    return *address;
+}
+
+void eeprom_read_block(void* destination, const void* source, size_t size)
+{
+    memcpy(destination, source, size);
+}
+
+void eeprom_update_byte(uint8_t* address, uint8_t value)
+{
+    *address = value;
+}
+
+void eeprom_update_word(uint16_t* address, uint16_t value)
+{
+    *address = value;
+}
+
+void eeprom_update_block(const void* source, void* destination, size_t size)
+{
+    memcpy(destination, source, size);
+}
+
+void wdt_enable(int timeout)
+{
+    (void)timeout;
+}
+
+void wdt_disable(void)
+{
+}
@@ -0,0 +1,20 @@
+/*
+ * File:   atomic.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <util/atomic.h>, a test runs ISRs between loop
+ * passes so the block only has to run its body once
+ */
+
+#ifndef HOST_UTIL_ATOMIC_H
+#define	HOST_UTIL_ATOMIC_H
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 1
+#define NONATOMIC_RESTORESTATE 0
+#define NONATOMIC_FORCEOFF 1
+
+#define ATOMIC_BLOCK(type) for(int hostAtomic = 1; hostAtomic; hostAtomic = 0)
+#define NONATOMIC_BLOCK(type) for(int hostAtomic = 1; hostAtomic; hostAtomic = 0)
+
+#endif	/* HOST_UTIL_ATOMIC_H */
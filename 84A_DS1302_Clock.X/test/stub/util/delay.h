@@ -0,0 +1,16 @@
+/*
+ * File:   delay.h
+ * Author: TallDwarf
+ *
+ * Host stand in for <util/delay.h>, delays add to a microsecond count
+ */
+
+#ifndef HOST_UTIL_DELAY_H
+#define	HOST_UTIL_DELAY_H
+
+extern double hostDelayMicroseconds;
+
+#define _delay_us(us) (hostDelayMicroseconds += (us))
+#define _delay_ms(ms) (hostDelayMicroseconds += (ms) * 1000.0)
+
+#endif	/* HOST_UTIL_DELAY_H */
@@ -0,0 +1,86 @@
+/*
+ * File:   test_alarm.c
+ * Author: TallDwarf
+ *
+ * Runs random alarm sets through several weeks of minute rollovers,
+ * some of them missed, and checks every alarm_check against a scan of
+ * the alarms between the previous and the current minute
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Alarm.h"
+#include "check.h"
+
+#define RUNS 2000
+#define WEEKS 3
+
+
+static Alarm alarms[ALARM_COUNT];
+
+//Any enabled alarm in (last, now], walking forward around the week
+static int reference_due(uint16_t last, uint16_t now)
+{
+    for(uint16_t m = last; m != now; )
+    {
+        m = (m + 1 == ALARM_MINUTES_PER_WEEK) ? 0 : m + 1;
+        
+        uint8_t day = m / ALARM_MINUTES_PER_DAY;
+        uint16_t minute = m % ALARM_MINUTES_PER_DAY;
+        
+        for(int i = 0; i < ALARM_COUNT; i++)
+            if((alarms[i].days & (1 << day)) && alarms[i].hour * 60 + alarms[i].minute == minute)
+                return 1;
+    }
+    
+    return 0;
+}
+
+static void random_alarms(void)
+{
+    for(int i = 0; i < ALARM_COUNT; i++)
+    {
+        //Few distinct times so duplicates are common, some disabled or erased
+        alarms[i].days = rand() & 0x7F;
+        alarms[i].hour = (rand() % 8 == 0) ? 0xFF : rand() % 3;
+        alarms[i].minute = rand() % 4;
+        
+        alarm_set(i, &alarms[i]);
+    }
+}
+
+int main(void)
+{
+    long fired = 0;
+    
+    srand(1);
+    
+    for(int run = 0; run < RUNS; run++)
+    {
+        random_alarms();
+        
+        uint16_t now = rand() % ALARM_MINUTES_PER_WEEK;
+        
+        alarm_sync(now);
+        
+        for(long step = 0; step < (long)WEEKS * ALARM_MINUTES_PER_WEEK; )
+        {
+            //Mostly single rollovers, sometimes a few are missed
+            uint16_t advance = (rand() % 16 == 0) ? 2 + rand() % 90 : 1;
+            uint16_t last = now;
+            
+            now = (now + advance) % ALARM_MINUTES_PER_WEEK;
+            step += advance;
+            
+            int expected = reference_due(last, now);
+            int due = alarm_check(now);
+            
+            CHECK(due == expected, "run %d: minute %u after %u, due %d, expected %d",
+                run, now, last, due, expected);
+            
+            fired += due;
+        }
+    }
+    
+    return check_report("alarm", "%ld alarms fired", fired);
+}
@@ -0,0 +1,63 @@
+/*
+ * File:   test_calendar.c
+ * Author: TallDwarf
+ *
+ * Walks every day of the DS1302 range, 2000-01-01 to 2099-12-31, and
+ * checks Calendar.c against a plain day by day count
+ */
+
+#include <stdio.h>
+#include "Calendar.h"
+#include "check.h"
+
+#define DAYS_IN_RANGE 36525
+
+
+//Full Gregorian rule, 2000 is a leap year by the 400 year exception
+static int reference_leap(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int reference_days_in_month(int year, int month)
+{
+    static const int days[13] = { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    
+    return (month == 2 && reference_leap(year)) ? 29 : days[month];
+}
+
+int main(void)
+{
+    //2000-01-01 was a Saturday, weekday 0 = Monday
+    int weekday = 5;
+    int days = 0;
+    
+    for(int year = 2000; year <= 2099; year++)
+    {
+        for(int month = 1; month <= 12; month++)
+        {
+            int length = reference_days_in_month(year, month);
+            
+            CHECK(calendar_days_in_month(year - 2000, month) == length,
+                "%04d-%02d: %d days, expected %d", year, month,
+                calendar_days_in_month(year - 2000, month), length);
+            
+            for(int date = 1; date <= length; date++)
+            {
+                //DS1302 day 1 is the first day of the week
+                int expected = (CALENDAR_EPOCH_DAY == 6) ? weekday + 1 : (weekday + 1) % 7 + 1;
+                int day = calendar_weekday(year - 2000, month, date);
+                
+                CHECK(day == expected, "%04d-%02d-%02d: day %d, expected %d",
+                    year, month, date, day, expected);
+                
+                weekday = (weekday + 1) % 7;
+                days++;
+            }
+        }
+    }
+    
+    CHECK(days == DAYS_IN_RANGE, "walked %d days, expected %d", days, DAYS_IN_RANGE);
+    
+    return check_report("calendar", "%d days", days);
+}
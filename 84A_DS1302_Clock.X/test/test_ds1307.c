@@ -0,0 +1,198 @@
+/*
+ * File:   test_ds1307.c
+ * Author: TallDwarf
+ *
+ * DS1307.c against a fake chip on the I2C bus. Clock registers must come
+ * back in DS1302 image order with the 12 hour flag moved, queued writes
+ * must land sorted as one transaction per run of registers, and a chip
+ * that does not answer must leave the image alone
+ * Also counts the bus bytes each read costs, cycles need the target
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DS1307.h"
+#include "fake_twi.h"
+#include "check.h"
+
+#define IMAGES 4096
+#define QUEUE_RUNS 2000
+
+
+static uint8_t to_bcd(uint8_t value)
+{
+    return ((value / 10) << 4) | (value % 10);
+}
+
+//Valid clock in DS1302 image order, either hour mode
+static void random_image(uint8_t* image)
+{
+    image[DS1302_IMAGE_SECOND] = to_bcd(rand() % 60);
+    image[DS1302_IMAGE_MINUTE] = to_bcd(rand() % 60);
+
+    if(rand() & 1)
+        image[DS1302_IMAGE_HOUR] = to_bcd(rand() % 24);
+    else
+        image[DS1302_IMAGE_HOUR] = 0x80 | ((rand() & 1) << 5) | to_bcd(1 + rand() % 12);
+
+    image[DS1302_IMAGE_DATE] = to_bcd(1 + rand() % 31);
+    image[DS1302_IMAGE_MONTH] = to_bcd(1 + rand() % 12);
+    image[DS1302_IMAGE_DAY] = to_bcd(1 + rand() % 7);
+    image[DS1302_IMAGE_YEAR] = to_bcd(rand() % 100);
+}
+
+//The same clock as the DS1307 holds it, datasheet register order
+static void image_to_registers(const uint8_t* image, uint8_t* registers)
+{
+    uint8_t hour = image[DS1302_IMAGE_HOUR];
+
+    registers[DS1307_SECOND] = image[DS1302_IMAGE_SECOND];
+    registers[DS1307_MINUTE] = image[DS1302_IMAGE_MINUTE];
+    registers[DS1307_HOUR] = (hour & 0x80) ? (DS1307_HOUR_12 | (hour & 0x3F)) : hour;
+    registers[DS1307_DAY] = image[DS1302_IMAGE_DAY];
+    registers[DS1307_DATE] = image[DS1302_IMAGE_DATE];
+    registers[DS1307_MONTH] = image[DS1302_IMAGE_MONTH];
+    registers[DS1307_YEAR] = image[DS1302_IMAGE_YEAR];
+}
+
+static void reset_chip(void)
+{
+    memset(&fakeTwi, 0, sizeof(fakeTwi));
+    fakeTwi.present = 1;
+}
+
+static void check_clock(void)
+{
+    for(int i = 0; i < IMAGES; i++)
+    {
+        uint8_t image[DS1302_IMAGE_SIZE];
+        uint8_t time[DS1302_IMAGE_SIZE];
+        uint8_t expected[DS1307_CLOCK_SIZE];
+
+        random_image(image);
+
+        //Read
+        reset_chip();
+        image_to_registers(image, fakeTwi.registers);
+        memset(time, 0xEE, sizeof(time));
+        read_time_ds1307(time);
+
+        CHECK(memcmp(time, image, DS1307_CLOCK_SIZE) == 0, "clock %d read back out of order", i);
+        CHECK(time[DS1302_IMAGE_WRITE_PROTECTION] == DS1302_UNPROTECT, "clock %d read as write protected", i);
+        CHECK(time[DS1302_IMAGE_TRICKLE_CHARGE] == 0xEE, "clock %d read past the clock", i);
+        CHECK(fakeTwi.starts == 2 && fakeTwi.stops == 1, "clock %d read took %lu starts", i, fakeTwi.starts);
+
+        //Write, the whole clock in one transaction
+        reset_chip();
+        queue_clock_ds1307(image);
+        commit_ds1307();
+        image_to_registers(image, expected);
+
+        CHECK(memcmp(fakeTwi.registers, expected, DS1307_CLOCK_SIZE) == 0, "clock %d written out of order", i);
+        CHECK(fakeTwi.starts == 1 && fakeTwi.written == DS1307_CLOCK_SIZE, "clock %d write took %lu starts", i, fakeTwi.starts);
+
+        //init takes a valid clock and refuses a broken one
+        reset_chip();
+        image_to_registers(image, fakeTwi.registers);
+        CHECK(init_ds1307(time) && memcmp(time, image, DS1307_CLOCK_SIZE) == 0, "clock %d refused by init", i);
+
+        fakeTwi.registers[DS1307_MONTH] = 0x13;
+        CHECK(!init_ds1307(time), "clock %d with month 13 taken by init", i);
+    }
+}
+
+//Random queued writes against a plain copy of the registers
+static void check_queue(void)
+{
+    for(int run = 0; run < QUEUE_RUNS; run++)
+    {
+        uint8_t reference[FAKE_TWI_REGISTERS];
+        int writes = 1 + rand() % (2 * DS1307_QUEUE_SIZE);
+
+        reset_chip();
+        memset(reference, 0, sizeof(reference));
+
+        for(int i = 0; i < writes; i++)
+        {
+            uint8_t address = DS1307_RAM(rand() % 16);
+            uint8_t data = rand();
+
+            reference[address] = data;
+
+            if(rand() & 1)
+                queue_deferred_ds1307(address, data);
+            else
+                queue_write_ds1307(address, data);
+
+            if(rand() % 4 == 0)
+                commit_ds1307();
+        }
+
+        flush_ds1307();
+
+        CHECK(memcmp(fakeTwi.registers, reference, sizeof(reference)) == 0, "queue run %d left different RAM", run);
+        CHECK(fakeTwi.starts <= fakeTwi.written, "queue run %d opened %lu writes for %lu bytes", run, fakeTwi.starts, fakeTwi.written);
+    }
+
+    //Out of order, two consecutive, goes out as three runs
+    reset_chip();
+    queue_write_ds1307(DS1307_RAM(8), 1);
+    queue_write_ds1307(DS1307_RAM(0), 2);
+    queue_write_ds1307(DS1307_RAM(20), 3);
+    queue_write_ds1307(DS1307_RAM(1), 4);
+    commit_ds1307();
+
+    CHECK(fakeTwi.starts == 3 && fakeTwi.stops == 3, "4 writes in 3 runs took %lu starts", fakeTwi.starts);
+    CHECK(fakeTwi.registers[DS1307_RAM(0)] == 2 && fakeTwi.registers[DS1307_RAM(1)] == 4 &&
+        fakeTwi.registers[DS1307_RAM(8)] == 1 && fakeTwi.registers[DS1307_RAM(20)] == 3, "runs landed on the wrong bytes");
+
+    //Deferred only waits
+    reset_chip();
+    queue_deferred_ds1307(DS1307_RAM(3), 5);
+    commit_ds1307();
+    CHECK(fakeTwi.starts == 0, "deferred write sent on its own");
+    flush_ds1307();
+    CHECK(fakeTwi.registers[DS1307_RAM(3)] == 5, "deferred write lost at flush");
+}
+
+static void check_absent(void)
+{
+    uint8_t time[DS1302_IMAGE_SIZE];
+    uint8_t before[DS1302_IMAGE_SIZE];
+
+    reset_chip();
+    fakeTwi.present = 0;
+    random_image(time);
+    memcpy(before, time, sizeof(time));
+
+    read_time_ds1307(time);
+    CHECK(memcmp(time, before, DS1307_CLOCK_SIZE) == 0, "absent chip changed the image");
+    CHECK(!init_ds1307(time), "absent chip taken by init");
+}
+
+int main(void)
+{
+    uint8_t time[DS1302_IMAGE_SIZE];
+    uint8_t data;
+
+    srand(1);
+
+    check_clock();
+    check_queue();
+    check_absent();
+
+    //Bus cost of the two reads the loop makes, address bytes included
+    reset_chip();
+    read_time_ds1307(time);
+    unsigned long timeBytes = fakeTwi.bytes;
+
+    reset_chip();
+    read_from_address_ds1307(DS1307_SECOND, &data);
+    unsigned long registerBytes = fakeTwi.bytes;
+
+    CHECK(timeBytes == 3 + DS1307_CLOCK_SIZE, "read time took %lu bytes", timeBytes);
+    CHECK(registerBytes == 4, "read register took %lu bytes", registerBytes);
+
+    return check_report("ds1307", "read time %lu bus bytes, read register %lu", timeBytes, registerBytes);
+}
@@ -0,0 +1,183 @@
+/*
+ * File:   test_dst.c
+ * Author: TallDwarf
+ *
+ * Dst.c over every hour the generated DstTable.h covers. The firmware
+ * wall clock moves by dst_check the way check_dst in main.c moves it and
+ * must stay inside the day and match standard time plus daylight saving
+ * worked out here from the rule. dst_sync at random hours, the repeated
+ * one included, must keep the stored state
+ * Build with DEFINES=-DDST_TEST_UTC_OFFSET=n for a table made with
+ * --utc-offset n
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Dst.h"
+#include "fake_rtc.h"
+#include "check.h"
+
+//For the rule defines, Dst.c owns the table itself
+#define dstDates testDstDates
+#include "DstTable.h"
+#undef dstDates
+
+#ifndef DST_TEST_UTC_OFFSET
+#define DST_TEST_UTC_OFFSET 0
+#endif
+
+//One sync every this many hours on average
+#define SYNC_ODDS 50
+
+//Standard time hours either side of a transition, month date hour
+#define KEY(month, date, hour) ((month) * 10000L + (date) * 100L + (hour))
+
+
+static uint8_t days_in_month(int year, int month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    return days[month - 1] + (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+}
+
+//0 = Sunday
+static int weekday(int year, int month, int date)
+{
+    static const int offsets[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+
+    if(month < 3)
+        year--;
+
+    return (year + year / 4 - year / 100 + year / 400 + offsets[month - 1] + date) % 7;
+}
+
+//nth Sunday of the month, n = -1 for the last
+static int sunday(int year, int month, int n)
+{
+    if(n < 0)
+    {
+        int last = days_in_month(year, month);
+        return last - weekday(year, month, last);
+    }
+
+    return 1 + (7 - weekday(year, month, 1)) % 7 + 7 * (n - 1);
+}
+
+//Daylight saving in effect at this local standard time hour
+//EU 01:00 UTC last Sunday of March to last Sunday of October
+//US 02:00 second Sunday of March to 02:00 daylight time first Sunday of November, from 2007
+static int reference_dst(int year, int month, int date, int hour)
+{
+    long now = KEY(month, date, hour);
+    long start;
+    long end;
+
+#if DST_END_MONTH == 10
+    start = KEY(3, sunday(year, 3, -1), 1 + DST_TEST_UTC_OFFSET);
+    end = KEY(10, sunday(year, 10, -1), 1 + DST_TEST_UTC_OFFSET);
+#elif DST_END_MONTH == 11
+    if(year < 2007)
+        return 0;
+
+    start = KEY(3, sunday(year, 3, 2), 2);
+    end = KEY(11, sunday(year, 11, 1), 1);
+#else
+#error "test_dst.c knows the EU and US rules only"
+#endif
+
+    return now >= start && now < end;
+}
+
+typedef struct
+{
+    int year;
+    int month;
+    int date;
+    int hour;
+} Clock;
+
+static void next_hour(Clock* clock)
+{
+    if(++clock->hour < 24)
+        return;
+
+    clock->hour = 0;
+
+    if(++clock->date <= days_in_month(clock->year, clock->month))
+        return;
+
+    clock->date = 1;
+
+    if(++clock->month <= 12)
+        return;
+
+    clock->month = 1;
+    clock->year++;
+}
+
+int main(void)
+{
+    Clock standard = {2000, 1, 1, 0};
+    Clock wall = standard;
+    unsigned long transitions = 0;
+    unsigned long syncs = 0;
+    unsigned long repeated = 0;
+    int lastHour = -1;
+
+    srand(1);
+
+    dst_sync(wall.year - 2000, wall.month, wall.date, wall.hour);
+    flush_ds1302();
+
+    while(standard.year < 2100)
+    {
+        int dst = reference_dst(standard.year, standard.month, standard.date, standard.hour);
+
+        //Wall clock moved only by dst_check, as check_dst moves it
+        int8_t change = dst_check(wall.year - 2000, wall.month, wall.date, wall.hour, 0);
+        wall.hour += change;
+        flush_ds1302();
+
+        if(change)
+            transitions++;
+
+        CHECK(wall.hour >= 0 && wall.hour <= 23, "%d-%02d-%02d moved the hour to %d",
+            wall.year, wall.month, wall.date, wall.hour);
+        Clock expected = standard;
+
+        if(dst)
+            next_hour(&expected);
+
+        CHECK(wall.year == expected.year && wall.month == expected.month && wall.date == expected.date &&
+            wall.hour == expected.hour, "%d-%02d-%02d %02d:00 standard shows %02d-%02d %02d:00",
+            standard.year, standard.month, standard.date, standard.hour, wall.month, wall.date, wall.hour);
+        CHECK(fakeRtc.ram[DST_RAM_INDEX] == dst, "%d-%02d-%02d %02d:00 standard stored %u",
+            standard.year, standard.month, standard.date, standard.hour, fakeRtc.ram[DST_RAM_INDEX]);
+
+        //Clock changed by hand, always in the hour before clocks go back
+        //so both of its passes on the day they do are covered
+        int ambiguous = wall.month == DST_END_MONTH && wall.hour == DST_END_HOUR - 1;
+
+        if(ambiguous && wall.hour == lastHour)
+            repeated++;
+
+        lastHour = wall.hour;
+
+        if(ambiguous || rand() % SYNC_ODDS == 0)
+        {
+            dst_sync(wall.year - 2000, wall.month, wall.date, wall.hour);
+            flush_ds1302();
+            syncs++;
+
+            CHECK(fakeRtc.ram[DST_RAM_INDEX] == dst, "sync at %d-%02d-%02d %02d:00 wall stored %u",
+                wall.year, wall.month, wall.date, wall.hour, fakeRtc.ram[DST_RAM_INDEX]);
+        }
+
+        next_hour(&standard);
+        next_hour(&wall);
+    }
+
+    CHECK(transitions == 2UL * (100 - DST_FIRST_YEAR), "%lu transitions from 20%02d", transitions, DST_FIRST_YEAR);
+
+    return check_report("dst", "%lu transitions, %lu syncs, %lu in a repeated hour", transitions, syncs, repeated);
+}
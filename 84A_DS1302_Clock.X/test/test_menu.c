@@ -0,0 +1,761 @@
+/*
+ * File:   test_menu.c
+ * Author: TallDwarf
+ *
+ * update_input, update_menu and set_clock_digits from main.c against
+ * simulated button pins, input ticks and Timer 1 ticks, with the RTC
+ * behind fake_rtc.c
+ * A breadth first search walks every reachable menu state from all 256
+ * menu bytes on a set of clock images, then a long random run holds
+ * buttons for random stretches. After every step the edited field must be
+ * valid BCD, at most one field is being edited, the display shows that
+ * field and the 12/24 toggle keeps the time of day
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//The menu code lives in main.c with the rest of the loop
+#include "firmware.h"
+
+#define RANDOM_STEPS 20000000L
+//Random run starts again from a fresh seed this often
+#define RANDOM_RESEED 4096
+
+//Button levels, a set bit is held down
+#define HOLD_LEFT (1 << 0)
+#define HOLD_CENTER (1 << 1)
+#define HOLD_RIGHT (1 << 2)
+#define HOLD_ALL (HOLD_LEFT | HOLD_CENTER | HOLD_RIGHT)
+
+//What passes before a loop pass: nothing, one fast repeat or a Timer 1 tick
+#define PASS_NOW 0
+#define PASS_REPEAT 1
+#define PASS_TICK 2
+#define PASSES 3
+
+//Input ticks in one Timer 1 tick, ~100Hz against 2Hz
+#define INPUT_TICKS_PER_TICK 50
+
+#define ACTIONS ((HOLD_ALL + 1) * PASSES)
+
+//Everything update_menu reads or writes, except RTC RAM which only
+//holds the event log and daylight saving flag here
+typedef struct
+{
+    uint8_t time[DS1302_IMAGE_SIZE];
+    uint8_t rtc[FAKE_RTC_REGISTERS];
+    uint8_t menuRaw;
+    uint8_t menuTimeout;
+    ButtonState buttons;
+    uint8_t inputTicks;
+    int8_t repeatDirection;
+    uint8_t repeatCount;
+    uint8_t repeatTime;
+    uint8_t flipFlop;
+    uint8_t timerMode;
+    uint8_t timerRunning;
+    uint8_t timerHundredths;
+    uint16_t timerSeconds;
+    uint8_t timerPreset;
+    uint8_t alarmRinging;
+    uint8_t levels;
+    uint8_t seed;
+} State;
+
+//Clock images the menu is opened on, seed 0 is the compiled in time
+#define SEEDS 5
+#define SEED_GARBAGE 4
+
+static uint8_t seedTimes[SEEDS][DS1302_IMAGE_SIZE] =
+{
+    [1] = { 0x00, 0x59, HOUR_24_COMBINE(2, 3, 0), 0x31, 0x12, 5, 0x99, DS1302_UNPROTECT, TRICKLE_CHARGE },
+    [2] = { 0x00, 0x00, HOUR_12_COMBINE(1, 2, 0), 0x29, 0x02, 4, 0x24, DS1302_UNPROTECT, TRICKLE_CHARGE },
+    [3] = { 0x00, 0x00, HOUR_24_COMBINE(0, 0, 0), 0x01, 0x01, 6, 0x00, DS1302_UNPROTECT, TRICKLE_CHARGE },
+    //A read that went wrong, every field out of range but the month
+    //still indexes the calendar tables
+    [SEED_GARBAGE] = { 0x7F, 0x7F, HOUR_12_COMBINE(1, 15, 0), 0x3F, 0x0C, 7, 0xFF, DS1302_UNPROTECT, TRICKLE_CHARGE }
+};
+
+//Breadth first node being expanded, -1 in the random run
+static long currentNode = -1;
+
+static void print_path(long node);
+
+//A failure also prints the button presses that led to it
+#define CHECK_DETAIL() print_path(currentNode)
+#include "check.h"
+
+///////////////////////
+//Simulated board
+//////////////////////
+
+static void set_buttons(uint8_t levels)
+{
+    //Pulled up, a held button pulls its pin LOW
+    LEFT_BUTTON_PIN |= (1 << LEFT_BUTTON);
+    CENTER_BUTTON_PIN |= (1 << CENTER_BUTTON);
+    RIGHT_BUTTON_PIN |= (1 << RIGHT_BUTTON);
+
+    if(levels & HOLD_LEFT)
+        LEFT_BUTTON_PIN &= ~(1 << LEFT_BUTTON);
+
+    if(levels & HOLD_CENTER)
+        CENTER_BUTTON_PIN &= ~(1 << CENTER_BUTTON);
+
+    if(levels & HOLD_RIGHT)
+        RIGHT_BUTTON_PIN &= ~(1 << RIGHT_BUTTON);
+}
+
+//One pass of the main loop input path after some time went by
+static void run_pass(uint8_t levels, uint8_t pass)
+{
+    if(pass == PASS_REPEAT)
+        inputTicks += REPEAT_FAST;
+    else if(pass == PASS_TICK)
+    {
+        inputTicks += INPUT_TICKS_PER_TICK;
+        TIM1_COMPA_vect();
+    }
+
+    set_buttons(levels);
+    update_input();
+    update_menu();
+    set_clock_digits();
+}
+
+static void take_state(State* s)
+{
+    memcpy(s->time, time_ds1302, DS1302_IMAGE_SIZE);
+    memcpy(s->rtc, fakeRtc.registers, FAKE_RTC_REGISTERS);
+    s->menuRaw = menu.Menu_Raw;
+    s->menuTimeout = menuTimeout;
+    s->buttons = buttons;
+    s->inputTicks = inputTicks;
+    s->repeatDirection = repeatDirection;
+    s->repeatCount = repeatCount;
+    s->repeatTime = repeatTime;
+    s->flipFlop = pending.FlipFlop;
+    s->timerMode = timerMode;
+    s->timerRunning = timerRunning;
+    s->timerHundredths = timerHundredths;
+    s->timerSeconds = timerSeconds;
+    s->timerPreset = timerPreset;
+    s->alarmRinging = alarmRinging;
+}
+
+static void put_state(const State* s)
+{
+    memcpy(time_ds1302, s->time, DS1302_IMAGE_SIZE);
+    memcpy(fakeRtc.registers, s->rtc, FAKE_RTC_REGISTERS);
+    menu.Menu_Raw = s->menuRaw;
+    menuTimeout = s->menuTimeout;
+    buttons = s->buttons;
+    inputTicks = s->inputTicks;
+    repeatDirection = s->repeatDirection;
+    repeatCount = s->repeatCount;
+    repeatTime = s->repeatTime;
+    pending.FlipFlop = s->flipFlop;
+    timerMode = s->timerMode;
+    timerRunning = s->timerRunning;
+    timerHundredths = s->timerHundredths;
+    timerSeconds = s->timerSeconds;
+    timerPreset = s->timerPreset;
+    alarmRinging = s->alarmRinging;
+}
+
+//Menu byte as restore_state leaves it after a watchdog reset, with the
+//clock halted if the menu was open, all buttons up
+static void seed_state(State* s, uint8_t seed, uint8_t menuRaw)
+{
+    memset(s, 0, sizeof(*s));
+    memcpy(s->time, seedTimes[seed], DS1302_IMAGE_SIZE);
+    memcpy(s->rtc, seedTimes[seed], FAKE_RTC_REGISTERS);
+
+    s->menuRaw = menuRaw;
+    s->menuTimeout = (menuRaw & 0x7F) ? MENU_TIMEOUT_MAX : 0;
+
+    if(menuRaw & 0x7F)
+        s->rtc[DS1302_IMAGE_SECOND] |= 0x80;
+
+    s->buttons.Left_Button_Stat = s->buttons.Left_Button_Old = HIGH;
+    s->buttons.Center_Button_Stat = s->buttons.Center_Button_Old = HIGH;
+    s->buttons.Right_Button_Stat = s->buttons.Right_Button_Old = HIGH;
+    s->flipFlop = 1;
+    s->timerPreset = TIMER_COUNTDOWN_DEFAULT;
+    s->seed = seed;
+}
+
+///////////////////////
+//Reference checks, written apart from the firmware
+//////////////////////
+
+static uint8_t from_bcd(uint8_t value)
+{
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+static int bcd_in_range(uint8_t value, uint8_t min, uint8_t max)
+{
+    return (value & 0x0F) <= 9 && (value >> 4) <= 9 &&
+            from_bcd(value) >= min && from_bcd(value) <= max;
+}
+
+static int is_12_hour(const uint8_t* image)
+{
+    return image[DS1302_IMAGE_HOUR] & 0x80;
+}
+
+static int hour_valid(const uint8_t* image)
+{
+    uint8_t hour = image[DS1302_IMAGE_HOUR];
+
+    if(is_12_hour(image))
+        return !(hour & 0x40) && bcd_in_range(hour & 0x1F, 1, 12);
+
+    return !(hour & 0x40) && bcd_in_range(hour & 0x3F, 0, 23);
+}
+
+static uint8_t hour_24(const uint8_t* image)
+{
+    uint8_t hour = image[DS1302_IMAGE_HOUR];
+
+    if(!is_12_hour(image))
+        return from_bcd(hour & 0x3F);
+
+    return from_bcd(hour & 0x1F) % 12 + ((hour & 0x20) ? 12 : 0);
+}
+
+//Register byte holds a value its field allows
+static int byte_valid(const uint8_t* image, uint8_t index)
+{
+    uint8_t value = image[index];
+
+    switch(index)
+    {
+        case DS1302_IMAGE_SECOND:
+            return bcd_in_range(value & 0x7F, 0, 59);
+        case DS1302_IMAGE_MINUTE:
+            return bcd_in_range(value, 0, 59);
+        case DS1302_IMAGE_HOUR:
+            return hour_valid(image);
+        case DS1302_IMAGE_DATE:
+            return bcd_in_range(value, 1, 31);
+        case DS1302_IMAGE_MONTH:
+            return bcd_in_range(value, 1, 12);
+        case DS1302_IMAGE_DAY:
+            return value >= 1 && value <= 7;
+        case DS1302_IMAGE_YEAR:
+            return bcd_in_range(value, 0, 99);
+    }
+
+    return 1;
+}
+
+static int image_valid(const uint8_t* image)
+{
+    static const uint8_t days[13] = { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    for(uint8_t i = DS1302_IMAGE_SECOND; i <= DS1302_IMAGE_YEAR; i++)
+        if(!byte_valid(image, i))
+            return 0;
+
+    uint8_t year = from_bcd(image[DS1302_IMAGE_YEAR]);
+    uint8_t month = from_bcd(image[DS1302_IMAGE_MONTH]);
+    uint8_t date = from_bcd(image[DS1302_IMAGE_DATE]);
+
+    if(month == 2 && (year % 4) != 0)
+        return date <= 28;
+
+    return date <= days[month];
+}
+
+//Image byte each menu field edits
+static const uint8_t fieldByte[7] =
+{
+    DS1302_IMAGE_MINUTE, DS1302_IMAGE_HOUR, DS1302_IMAGE_HOUR, DS1302_IMAGE_DATE,
+    DS1302_IMAGE_MONTH, DS1302_IMAGE_DAY, DS1302_IMAGE_YEAR
+};
+
+static const char* const fieldName[7] =
+{
+    "minutes", "hours", "12/24", "date", "month", "reserved", "year"
+};
+
+//Lowest set field, the one update_menu and set_clock_digits act on
+static int field_index(uint8_t enabled)
+{
+    for(int i = 0; i < 7; i++)
+        if(enabled & (1 << i))
+            return i;
+
+    return -1;
+}
+
+//Segments the menu should show for a field, FALSE if the field holds
+//digits that cannot be drawn
+static int expected_digits(int field, const uint8_t* image, uint8_t* digits)
+{
+    uint8_t value = image[fieldByte[field]];
+    uint8_t high = value >> 4;
+    uint8_t low = value & 0x0F;
+
+    memset(digits, 0x00, 4);
+
+    switch(field)
+    {
+        case 1:
+            high &= is_12_hour(image) ? 0x01 : 0x03;
+            break;
+        case 2:
+            high = is_12_hour(image) ? 1 : 2;
+            low = is_12_hour(image) ? 2 : 4;
+            break;
+        case 3:
+            high &= 0x03;
+            break;
+        case 4:
+            high &= 0x01;
+            break;
+        case 6:
+            digits[0] = segmentNumbers[2];
+            digits[1] = segmentNumbers[0];
+            break;
+    }
+
+    if(high > 9 || low > 9)
+        return 0;
+
+    //Minutes, month, year and 24 on the right, the rest on the left
+    int right = (field == 0 || field == 4 || field == 6 || (field == 2 && !is_12_hour(image)));
+
+    digits[right ? 2 : 0] = segmentNumbers[high];
+    digits[right ? 3 : 1] = segmentNumbers[low];
+
+    return 1;
+}
+
+///////////////////////
+//Coverage
+//////////////////////
+
+//Field values shown while setting, [field][value] with hours split by mode
+#define COVER_HOURS_12 5
+static uint8_t covered[7][100];
+static long opened, saved, timedOut, silenced, coarseSteps, timerEntered;
+
+static void cover(const State* before)
+{
+    uint8_t field = menu.Menu_State.enabled;
+
+    if(!(before->menuRaw & 0x7F) && field && timerMode == TIMER_OFF)
+        opened++;
+
+    //Closed by right while selecting, or by the timeout
+    if((before->menuRaw & 0x7F) && before->timerMode == TIMER_OFF && !field)
+    {
+        if(PRESSED(buttons.Right_Button_Old, buttons.Right_Button_Stat))
+            saved++;
+        else
+            timedOut++;
+    }
+
+    if(before->alarmRinging && !alarmRinging)
+        silenced++;
+
+    if(before->timerMode == TIMER_OFF && timerMode != TIMER_OFF)
+        timerEntered++;
+
+    if(repeatCount == REPEAT_COARSE_COUNT && before->repeatCount == REPEAT_COARSE_COUNT &&
+            repeatTime != before->repeatTime)
+        coarseSteps++;
+
+    int index = field_index(field);
+
+    if(index < 0 || !menu.Menu_State.setting || !byte_valid(time_ds1302, fieldByte[index]))
+        return;
+
+    uint8_t value = from_bcd(time_ds1302[fieldByte[index]] & (index == 1 ? (is_12_hour(time_ds1302) ? 0x1F : 0x3F) : 0xFF));
+
+    if(index == 1 && is_12_hour(time_ds1302))
+        index = COVER_HOURS_12;
+    else if(index == 2)
+        value = is_12_hour(time_ds1302) ? 12 : 24;
+
+    if(value < 100)
+        covered[index][value] = 1;
+}
+
+static int covered_count(int index)
+{
+    int count = 0;
+
+    for(int i = 0; i < 100; i++)
+        count += covered[index][i];
+
+    return count;
+}
+
+///////////////////////
+//Invariants
+//////////////////////
+
+static void check_pass(const State* before)
+{
+    uint8_t field = menu.Menu_State.enabled;
+    int wasOpen = (before->menuRaw & 0x7F) != 0 && before->timerMode == TIMER_OFF;
+
+    CHECK(menuTimeout <= MENU_TIMEOUT_MAX, "menu timeout %u", menuTimeout);
+    CHECK(fakeRtc.queued == 0, "%u RTC writes left in the queue", fakeRtc.queued);
+
+    if(timerMode != TIMER_OFF)
+        return;
+
+    if(field)
+    {
+        CHECK((field & (field - 1)) == 0 && field != MENU_RESERVED_FIELD,
+            "menu byte 0x%02X does not edit exactly one field", menu.Menu_Raw);
+        CHECK(FAKE_RTC_HALTED(), "clock running with the menu open");
+
+        //Any byte the pass wrote has to hold a value its field allows
+        for(uint8_t i = DS1302_IMAGE_MINUTE; i <= DS1302_IMAGE_YEAR; i++)
+            if(time_ds1302[i] != before->time[i])
+                CHECK(byte_valid(time_ds1302, i), "%s edited to 0x%02X from 0x%02X",
+                    fieldName[field_index(field)], time_ds1302[i], before->time[i]);
+
+        //Toggle keeps the time of day, the hour register is rewritten
+        if(is_12_hour(time_ds1302) != is_12_hour(before->time) && hour_valid(before->time))
+            CHECK(hour_24(time_ds1302) == hour_24(before->time),
+                "12/24 toggle moved hour 0x%02X to 0x%02X", before->time[DS1302_IMAGE_HOUR],
+                time_ds1302[DS1302_IMAGE_HOUR]);
+
+        //Shown while setting and on the flip flop, blank otherwise
+        int index = field_index(field);
+        uint8_t digits[4] = { 0 };
+        int drawable = expected_digits(index, time_ds1302, digits);
+
+        if(!(pending.FlipFlop || menu.Menu_State.setting))
+            memset(digits, 0x00, 4);
+        else if(!drawable)
+            return;
+
+        for(uint8_t i = 0; i < 4; i++)
+            CHECK(display_frame[i] == DISPLAY_SEGMENT_MAP(i, digits[i]),
+                "%s 0x%02X digit %u shows 0x%02X, expected 0x%02X", fieldName[index],
+                time_ds1302[fieldByte[index]], i, display_frame[i], DISPLAY_SEGMENT_MAP(i, digits[i]));
+    }
+    else if(wasOpen)
+    {
+        //Saved, the whole clock went out and started in one commit
+        CHECK(!FAKE_RTC_HALTED(), "clock still halted after the menu closed");
+        CHECK(memcmp(fakeRtc.registers, time_ds1302, 7) == 0, "RTC differs from the saved image");
+
+        if(before->seed != SEED_GARBAGE)
+            CHECK(image_valid(time_ds1302), "saved an invalid clock %02X %02X %02X %02X %02X",
+                time_ds1302[DS1302_IMAGE_MINUTE], time_ds1302[DS1302_IMAGE_HOUR],
+                time_ds1302[DS1302_IMAGE_DATE], time_ds1302[DS1302_IMAGE_MONTH],
+                time_ds1302[DS1302_IMAGE_YEAR]);
+    }
+}
+
+static void step(State* s, uint8_t levels, uint8_t pass)
+{
+    put_state(s);
+
+    State before = *s;
+
+    run_pass(levels, pass);
+    take_state(s);
+    s->levels = levels;
+
+    check_pass(&before);
+    cover(&before);
+}
+
+///////////////////////
+//Breadth first search
+//////////////////////
+
+typedef struct
+{
+    State state;
+    long parent;
+    uint8_t action;
+    uint16_t depth;
+} Node;
+
+static Node* nodes;
+static long nodeCount, nodeCapacity;
+
+static uint64_t* visited;
+static uint64_t visitedMask;
+static long visitedCount;
+
+//Menu, edited field value, buttons and timeout, plus what decides the
+//next pass: repeat stage, flip flop, timer and alarm state
+static uint64_t state_key(const State* s)
+{
+    uint8_t value = 0;
+    int index = field_index(s->menuRaw & 0x7F);
+
+    if(s->timerMode != TIMER_OFF)
+        value = s->timerPreset;
+    else if(index >= 0)
+        value = s->time[fieldByte[index]];
+
+    uint8_t stage = (s->repeatCount == 0) ? 0 : (s->repeatCount <= REPEAT_SLOW_COUNT) ? 1 :
+            (s->repeatCount < REPEAT_COARSE_COUNT) ? 2 : 3;
+
+    uint64_t key = s->seed;
+
+    key = (key << 8) | s->menuRaw;
+    key = (key << 8) | value;
+    key = (key << 1) | (is_12_hour(s->time) ? 1 : 0);
+    key = (key << 3) | s->levels;
+    key = (key << 4) | s->menuTimeout;
+    key = (key << 2) | stage;
+    key = (key << 1) | s->flipFlop;
+    key = (key << 2) | s->timerMode;
+    key = (key << 1) | (s->timerRunning ? 1 : 0);
+    key = (key << 1) | (s->alarmRinging ? 1 : 0);
+
+    return key + 1;
+}
+
+static void grow_visited(void);
+
+//TRUE if the state was not seen before
+static int visit(const State* s)
+{
+    uint64_t key = state_key(s);
+    uint64_t slot = (key * 0x9E3779B97F4A7C15ull) >> 20;
+
+    for(;; slot++)
+    {
+        slot &= visitedMask;
+
+        if(visited[slot] == key)
+            return 0;
+
+        if(visited[slot] == 0)
+            break;
+    }
+
+    visited[slot] = key;
+
+    if(++visitedCount * 2 > (long)visitedMask)
+        grow_visited();
+
+    return 1;
+}
+
+static void grow_visited(void)
+{
+    uint64_t* old = visited;
+    uint64_t oldMask = visitedMask;
+
+    visitedMask = oldMask ? (oldMask << 1) | 1 : (1 << 20) - 1;
+    visited = calloc(visitedMask + 1, sizeof(uint64_t));
+
+    if(!visited)
+    {
+        printf("out of memory\n");
+        exit(1);
+    }
+
+    for(uint64_t i = 0; old && i <= oldMask; i++)
+    {
+        if(old[i] == 0)
+            continue;
+
+        uint64_t slot = (old[i] * 0x9E3779B97F4A7C15ull) >> 20;
+
+        while(visited[slot & visitedMask])
+            slot++;
+
+        visited[slot & visitedMask] = old[i];
+    }
+
+    free(old);
+}
+
+static void add_node(const State* s, long parent, uint8_t action, uint16_t depth)
+{
+    if(nodeCount == nodeCapacity)
+    {
+        nodeCapacity = nodeCapacity ? nodeCapacity * 2 : 1 << 16;
+        nodes = realloc(nodes, nodeCapacity * sizeof(Node));
+
+        if(!nodes)
+        {
+            printf("out of memory\n");
+            exit(1);
+        }
+    }
+
+    nodes[nodeCount].state = *s;
+    nodes[nodeCount].parent = parent;
+    nodes[nodeCount].action = action;
+    nodes[nodeCount].depth = depth;
+    nodeCount++;
+}
+
+//Seed then one LCR/. r t group per pass, held buttons then what passed
+static void print_path(long node)
+{
+    if(node < 0 || failures > 3)
+        return;
+
+    char path[4096];
+    int length = sizeof(path) - 1;
+
+    path[length] = '\0';
+
+    for(long n = node; nodes[n].parent >= 0 && length > 8; n = nodes[n].parent)
+    {
+        uint8_t levels = nodes[n].action / PASSES;
+        uint8_t pass = nodes[n].action % PASSES;
+
+        path[--length] = ' ';
+        path[--length] = "_rt"[pass];
+        path[--length] = (levels & HOLD_RIGHT) ? 'R' : '-';
+        path[--length] = (levels & HOLD_CENTER) ? 'C' : '-';
+        path[--length] = (levels & HOLD_LEFT) ? 'L' : '-';
+    }
+
+    long root = node;
+
+    while(nodes[root].parent >= 0)
+        root = nodes[root].parent;
+
+    printf("  from seed %u menu 0x%02X: %s\n", nodes[root].state.seed, nodes[root].state.menuRaw, &path[length]);
+}
+
+static void search(void)
+{
+    State s;
+    uint16_t depth = 0;
+    long transitions = 0;
+
+    grow_visited();
+
+    for(uint8_t seed = 0; seed < SEEDS; seed++)
+    {
+        for(int raw = 0; raw < 256; raw++)
+        {
+            seed_state(&s, seed, raw);
+
+            if(visit(&s))
+                add_node(&s, -1, 0, 0);
+        }
+
+        //Clock showing with an alarm going off
+        seed_state(&s, seed, 0);
+        s.alarmRinging = ALARM_RING_MAX;
+
+        if(visit(&s))
+            add_node(&s, -1, 0, 0);
+    }
+
+    long seeds = nodeCount;
+
+    for(long n = 0; n < nodeCount; n++)
+    {
+        for(uint8_t action = 0; action < ACTIONS; action++)
+        {
+            currentNode = n;
+            s = nodes[n].state;
+            step(&s, action / PASSES, action % PASSES);
+            transitions++;
+
+            if(visit(&s))
+            {
+                add_node(&s, n, action, nodes[n].depth + 1);
+
+                if(nodes[n].depth + 1 > depth)
+                    depth = nodes[n].depth + 1;
+            }
+        }
+    }
+
+    currentNode = -1;
+
+    printf("menu: search from %ld seeds, %ld states, %ld passes, depth %u\n",
+        seeds, nodeCount, transitions, depth);
+}
+
+///////////////////////
+//Random run
+//////////////////////
+
+static uint32_t randomState = 1;
+
+static uint32_t next_random(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return randomState;
+}
+
+static void random_run(void)
+{
+    State s;
+    uint8_t levels = 0;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(long i = 0; i < RANDOM_STEPS; i++)
+    {
+        uint32_t r = next_random();
+
+        if(i % RANDOM_RESEED == 0)
+        {
+            seed_state(&s, (r >> 8) % SEEDS, r >> 16);
+
+            //Alarms only go off with the menu closed
+            if((r & 0x07) == 0 && !(s.menuRaw & 0x7F))
+                s.alarmRinging = ALARM_RING_MAX;
+        }
+
+        //Buttons stay put for a while so holds reach every repeat stage
+        if((r & 0x0F) == 0)
+            levels = (r >> 4) & HOLD_ALL;
+
+        uint8_t roll = (r >> 24) % 10;
+        uint8_t pass = (roll < 5) ? PASS_NOW : (roll < 9) ? PASS_REPEAT : PASS_TICK;
+
+        step(&s, levels, pass);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+
+    printf("menu: random %ld passes in %.2fs, %.1f million passes/s\n",
+        RANDOM_STEPS, seconds, RANDOM_STEPS / seconds * 1e-6);
+}
+
+int main(void)
+{
+    memcpy(seedTimes[0], time_ds1302, DS1302_IMAGE_SIZE);
+
+    search();
+    random_run();
+
+    printf("menu: values set, minutes %d/60, hours %d/24 + %d/12, 12/24 %d/2, "
+        "date %d/31, month %d/12, year %d/100\n",
+        covered_count(0), covered_count(1), covered_count(COVER_HOURS_12), covered_count(2),
+        covered_count(3), covered_count(4), covered_count(6));
+    printf("menu: passes that opened %ld, saved %ld, timed out %ld, stepped by ten %ld, "
+        "started a timer %ld, silenced an alarm %ld\n",
+        opened, saved, timedOut, coarseSteps, timerEntered, silenced);
+    free(nodes);
+    free(visited);
+
+    return check_report("menu", NULL);
+}
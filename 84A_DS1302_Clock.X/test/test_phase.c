@@ -0,0 +1,229 @@
+/*
+ * File:   test_phase.c
+ * Author: TallDwarf
+ *
+ * update_time from main.c against a Timer 1 running off an oscillator
+ * with a set error, and a fake DS1302 whose seconds roll on real time
+ * Each run checks how late the display takes a new second, how many
+ * times a second the RTC is read once the lock has settled and that
+ * every tick runs its full set of hundredths
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+//The phase code lives in main.c with the rest of the loop
+#include "firmware.h"
+#include "check.h"
+
+//Simulated seconds per run, the first SETTLE_SECONDS are not counted
+#define RUN_SECONDS 600
+#define SETTLE_SECONDS 30
+
+//Loop pass length in microseconds, varies between these
+#define PASS_MIN_US 150
+#define PASS_MAX_US 450
+
+//Timer 1 counts per microsecond at the nominal 8MHz / 64
+#define COUNTS_PER_US 0.125
+
+//RTC edges do not line up with the start of the run
+#define RTC_OFFSET 0.3712
+
+//Latency bound, the check window plus two passes
+#define LATENCY_MAX_US (PHASE_CHECK_COUNTS / COUNTS_PER_US + 2 * PASS_MAX_US)
+
+//Seconds reads with a steady oscillator, two a second plus the minute
+//burst. A moving one adds a hunt now and then
+#define READS_STEADY 2.05
+#define READS_DRIFTING 3.0
+
+
+typedef struct
+{
+    const char* name;
+    //Oscillator error, fraction of nominal
+    double error;
+    //Slow swing on top of it, amplitude and period in seconds
+    double swing;
+    double swingPeriod;
+    double readsMax;
+} Run;
+
+static const Run runs[] =
+{
+    { "-3%", -0.03, 0, 1, READS_STEADY },
+    { "-1%", -0.01, 0, 1, READS_STEADY },
+    { "-0.05%", -0.0005, 0, 1, READS_STEADY },
+    { "0", 0, 0, 1, READS_STEADY },
+    { "+0.05%", 0.0005, 0, 1, READS_STEADY },
+    { "+1%", 0.01, 0, 1, READS_STEADY },
+    { "+2%", 0.02, 0, 1, READS_STEADY },
+    { "drift 0.5%", 0, 0.005, 240, READS_DRIFTING },
+    { "drift 2%", 0.01, 0.02, 120, READS_DRIFTING }
+};
+
+static uint32_t randomState = 1;
+
+static uint32_t next_random(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return randomState;
+}
+
+static uint8_t to_bcd(uint8_t value)
+{
+    return ((value / 10) << 4) | (value % 10);
+}
+
+//Clock registers at real time t
+static void set_rtc(double t)
+{
+    unsigned long seconds = (unsigned long)(t + RTC_OFFSET);
+
+    fakeRtc.registers[DS1302_IMAGE_SECOND] = to_bcd(seconds % 60);
+    fakeRtc.registers[DS1302_IMAGE_MINUTE] = to_bcd((seconds / 60) % 60);
+    fakeRtc.registers[DS1302_IMAGE_HOUR] = to_bcd((seconds / 3600) % 24);
+}
+
+//Fresh firmware state as boot leaves it, hunting for the first edge
+static void reset_firmware(void)
+{
+    memset(&fakeRtc, 0, sizeof(fakeRtc));
+    memcpy(fakeRtc.registers, time_ds1302, DS1302_IMAGE_SIZE);
+    set_rtc(0);
+    memcpy(time_ds1302, fakeRtc.registers, 8);
+
+    phaseState = PHASE_HUNTING;
+    phaseHuntTicks = 0;
+    phaseReference = FALSE;
+    phaseTrimmed = FALSE;
+    phaseSteady = FALSE;
+    phaseOffset = 0;
+    phaseTicks = 0;
+    tickAccumulator = 0;
+    set_tick_period();
+
+    TCNT1 = 0;
+    OCR1A = tickBase;
+    OCR1B = 0xFFFF;
+    pending.Time = FALSE;
+    pending.FlipFlop = FALSE;
+}
+
+static void run(const Run* r)
+{
+    double t = 0;
+    //Timer 1 with its fraction, TCNT1 holds the whole counts
+    double counts = 0;
+    double latencyMax = 0;
+    double latencySum = 0;
+    long latencies = 0;
+    long hunts = 0;
+    //Compare B matches since the tick started, none counted before the first
+    int steps = -1;
+    unsigned long readsStart = 0;
+    uint8_t lastState = PHASE_HUNTING;
+    uint8_t lastSecond;
+
+    reset_firmware();
+    lastSecond = time_ds1302[DS1302_IMAGE_SECOND];
+
+    while(t < RUN_SECONDS)
+    {
+        double error = r->error + r->swing * sin(2 * M_PI * t / r->swingPeriod);
+        double rate = COUNTS_PER_US * (1 + error);
+        double pass = PASS_MIN_US + (next_random() % (PASS_MAX_US - PASS_MIN_US + 1));
+        double target = counts + pass * rate;
+
+        //Compare matches in order, compare A clears TCNT1 on the count after
+        while(1)
+        {
+            double wrap = (double)OCR1A + 1;
+            double matchB = (OCR1B > counts && OCR1B <= OCR1A) ? OCR1B : 1e9;
+
+            if(matchB <= target && matchB < wrap)
+            {
+                counts = matchB;
+                TCNT1 = OCR1B;
+                TIM1_COMPB_vect();
+                steps++;
+            }
+            else if(wrap <= target)
+            {
+                CHECK(steps < 0 || steps == TIMER_STEPS_PER_TICK - 1, "%s: %d hundredths in the tick at %.3fs", r->name, steps + 1, t);
+                steps = 0;
+                target -= wrap;
+                counts = 0;
+                TCNT1 = 0;
+                TIM1_COMPA_vect();
+            }
+            else
+                break;
+        }
+
+        counts = target;
+        TCNT1 = (uint16_t)counts;
+        t += pass * 1e-6;
+
+        set_rtc(t);
+        update_time();
+
+        //lock_phase restarts the timer and the hundredths with it
+        if(TCNT1 != (uint16_t)counts)
+        {
+            counts = TCNT1;
+            steps = 0;
+        }
+
+        //Flags clear on a written one, here that write would set them
+        //Compares are serviced at once so none is ever left pending
+        TIFR1 = 0;
+
+        if(phaseState == PHASE_HUNTING && lastState != PHASE_HUNTING && t > SETTLE_SECONDS)
+            hunts++;
+
+        lastState = phaseState;
+
+        if(t > SETTLE_SECONDS && readsStart == 0)
+            readsStart = fakeRtc.transactions;
+
+        //Time from the RTC edge until the image holds the new second
+        if(time_ds1302[DS1302_IMAGE_SECOND] != lastSecond)
+        {
+            double latency = (t + RTC_OFFSET - floor(t + RTC_OFFSET)) * 1e6;
+
+            lastSecond = time_ds1302[DS1302_IMAGE_SECOND];
+
+            if(t > SETTLE_SECONDS)
+            {
+                if(latency > latencyMax)
+                    latencyMax = latency;
+
+                latencySum += latency;
+                latencies++;
+            }
+        }
+    }
+
+    double reads = (double)(fakeRtc.transactions - readsStart) / (RUN_SECONDS - SETTLE_SECONDS);
+
+    printf("phase: %-10s latency mean %4.0fus max %5.0fus, %.2f reads/s, %ld hunts\n",
+        r->name, latencySum / latencies, latencyMax, reads, hunts);
+
+    CHECK(latencies >= RUN_SECONDS - SETTLE_SECONDS - 1, "%s: %ld seconds shown", r->name, latencies);
+    CHECK(latencyMax <= LATENCY_MAX_US, "%s: latency %.0fus", r->name, latencyMax);
+    CHECK(reads <= r->readsMax, "%s: %.2f reads/s", r->name, reads);
+}
+
+int main(void)
+{
+    for(unsigned i = 0; i < sizeof(runs) / sizeof(runs[0]); i++)
+        run(&runs[i]);
+
+    return check_report("phase", "%u runs of %ds", (unsigned)(sizeof(runs) / sizeof(runs[0])), RUN_SECONDS);
+}
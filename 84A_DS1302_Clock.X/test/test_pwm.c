@@ -0,0 +1,92 @@
+/*
+ * File:   test_pwm.c
+ * Author: TallDwarf
+ *
+ * Output enable dithering from main.c, one Timer 0 overflow at a time
+ * Every duty the curve can hold must average out to itself over a dither
+ * cycle and above the duty before it, and a new target must be reached
+ * one step per cycle
+ * Frequencies follow from the prescaler and need the target to measure
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//The dither lives in main.c with the rest of the PWM
+#include "firmware.h"
+#include "check.h"
+
+#define DITHER_PERIODS (1 << BRIGHTNESS_DITHER_BITS)
+
+//Largest duty that still fits OCR0A on the top dither period
+#define DUTY_MAX (255 << BRIGHTNESS_DITHER_BITS)
+
+
+//OCR0A summed over one dither cycle, in 1 / DITHER_PERIODS counts
+static unsigned dither_cycle(void)
+{
+    unsigned sum = 0;
+
+    for(int i = 0; i < DITHER_PERIODS; i++)
+    {
+        TIM0_OVF_vect();
+        sum += OCR0A;
+    }
+
+    return sum;
+}
+
+static void set_duty(uint16_t duty)
+{
+    brightnessDuty = duty;
+    brightnessTarget = duty;
+    brightnessPhase = DITHER_PERIODS - 1;
+}
+
+int main(void)
+{
+    unsigned steps = 0;
+    unsigned last = 0;
+
+    for(uint16_t duty = 0; duty <= DUTY_MAX; duty++)
+    {
+        set_duty(duty);
+
+        unsigned sum = dither_cycle();
+
+        CHECK(sum == duty, "duty %u averages %u / %d", duty, sum, DITHER_PERIODS);
+        //Output enable is active LOW, a higher duty is a dimmer display
+        CHECK(duty == 0 || sum > last, "duty %u holds OCR0A no higher than duty %u", duty, duty - 1);
+
+        if(duty == 0 || sum != last)
+            steps++;
+
+        last = sum;
+    }
+
+    //Slew from both ends of the curve, one step per dither cycle
+    for(int direction = 0; direction < 2; direction++)
+    {
+        uint16_t from = direction ? brightness_curve[255] : brightness_curve[0];
+        uint16_t to = direction ? brightness_curve[0] : brightness_curve[255];
+        unsigned cycles = 0;
+
+        set_duty(from);
+        brightnessTarget = to;
+
+        while(brightnessDuty != to && cycles <= DUTY_MAX)
+        {
+            uint16_t before = brightnessDuty;
+
+            dither_cycle();
+            cycles++;
+
+            CHECK(brightnessDuty == before + 1 || brightnessDuty == before - 1,
+                "slew from %u moved to %u in one cycle", before, brightnessDuty);
+        }
+
+        CHECK(cycles == (unsigned)abs((int)to - (int)from), "slew %u to %u took %u cycles", from, to, cycles);
+    }
+
+    return check_report("pwm", "%u duty steps", steps);
+}
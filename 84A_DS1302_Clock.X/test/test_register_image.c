@@ -0,0 +1,98 @@
+/*
+ * File:   test_register_image.c
+ * Author: TallDwarf
+ *
+ * The DS1302_GET/SET/TOGGLE accessors must produce the same bytes as the
+ * DS1302_DATA_SET bitfields they replaced, so burst writes are unchanged
+ * Every field is read, set to every value and toggled on random images
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "DS1302.h"
+#include "check.h"
+
+#define IMAGES 4096
+
+typedef union
+{
+    DS1302_DATA_SET bits;
+    uint8_t bytes[DS1302_IMAGE_SIZE];
+} Image;
+
+_Static_assert(sizeof(DS1302_DATA_SET) == DS1302_IMAGE_SIZE, "Bitfield struct is not the register image");
+
+
+static void random_image(Image* image)
+{
+    for(int i = 0; i < DS1302_IMAGE_SIZE; i++)
+        image->bytes[i] = rand();
+}
+
+//Accessor field against the bitfield member it replaced
+#define CHECK_FIELD(name, member, width) \
+    do { \
+        Image start; \
+        random_image(&start); \
+        \
+        Image a = start; \
+        CHECK(DS1302_GET(a.bytes, DS1302_F_##name) == a.bits.member, \
+            "%s: get %u, bitfield %u", #member, DS1302_GET(a.bytes, DS1302_F_##name), a.bits.member); \
+        \
+        for(unsigned value = 0; value < (1u << (width)); value++) \
+        { \
+            Image b = start; \
+            a = start; \
+            DS1302_SET(a.bytes, DS1302_F_##name, value); \
+            b.bits.member = value; \
+            CHECK(memcmp(a.bytes, b.bytes, DS1302_IMAGE_SIZE) == 0, \
+                "%s: set %u gives different bytes", #member, value); \
+        } \
+        \
+        Image b = start; \
+        a = start; \
+        DS1302_TOGGLE(a.bytes, DS1302_F_##name); \
+        b.bits.member ^= (1u << (width)) - 1; \
+        CHECK(memcmp(a.bytes, b.bytes, DS1302_IMAGE_SIZE) == 0, \
+            "%s: toggle gives different bytes", #member); \
+    } while(0)
+
+int main(void)
+{
+    srand(1);
+    
+    for(int i = 0; i < IMAGES; i++)
+    {
+        CHECK_FIELD(SECONDS, seconds, 4);
+        CHECK_FIELD(SECONDS_X10, secondsX10, 3);
+        CHECK_FIELD(CLOCK_HALT, clockHalt, 1);
+        CHECK_FIELD(MINUTES, minutes, 4);
+        CHECK_FIELD(MINUTES_X10, minutesX10, 3);
+        CHECK_FIELD(HOUR, H24.hour, 4);
+        CHECK_FIELD(HOUR, H12.hour, 4);
+        CHECK_FIELD(HOUR24_X10, H24.hourX10, 2);
+        CHECK_FIELD(HOUR12_X10, H12.hourX10, 1);
+        CHECK_FIELD(AM_PM, H12.hour_AM_PM, 1);
+        CHECK_FIELD(HOUR_MODE, H24.hour_12_24, 1);
+        CHECK_FIELD(HOUR_MODE, H12.hour_12_24, 1);
+        CHECK_FIELD(DATE, date, 4);
+        CHECK_FIELD(DATE_X10, dateX10, 2);
+        CHECK_FIELD(MONTH, month, 4);
+        CHECK_FIELD(MONTH_X10, monthX10, 1);
+        CHECK_FIELD(DAY, day, 3);
+        CHECK_FIELD(YEAR, year, 4);
+        CHECK_FIELD(YEAR_X10, yearX10, 4);
+        CHECK_FIELD(WRITE_PROTECTION, writeProtection, 1);
+        CHECK_FIELD(TRICKLE_CHARGE, trickleCharger, 8);
+        
+        //Whole image in burst order
+        Image image;
+        random_image(&image);
+        CHECK(image.bytes[DS1302_IMAGE_YEAR] == (image.bits.yearX10 << 4 | image.bits.year) &&
+            image.bytes[DS1302_IMAGE_TRICKLE_CHARGE] == image.bits.trickleCharger,
+            "image byte order differs from the bitfield struct");
+    }
+    
+    return check_report("register image", NULL);
+}
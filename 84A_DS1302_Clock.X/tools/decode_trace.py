@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+#
+# Decodes a VCD bus trace recorded with SimTrace.c
+#
+# Rebuilds DS1302 commands and latched 595 frames, checks edge timing
+# against the datasheet minimums and reports how busy each bus is
+#
+# Usage: python3 tools/decode_trace.py bus_trace.vcd [--vcc 5|2] [--list]
+#                                      [--digits N] [--msb-first] [--chain-in-order]
+#        python3 tools/decode_trace.py A.vcd B.vcd...
+#
+# Traces built with BENCH also get cycles per Bench.h marker, several
+# traces are compared side by side
+#
+# Exits with 1 if any timing or protocol violation was found
+
+import argparse
+import collections
+import os
+import sys
+
+#Datasheet minimums in ns, DS1302 at 2V/5V, 74HC595 at 2V/4.5V
+DS1302_TIMING = {
+    2: {"tDC": 200, "tCDH": 280, "tCL": 1000, "tCH": 1000, "tCC": 4000, "tCCH": 240, "tCWH": 4000},
+    5: {"tDC": 50, "tCDH": 70, "tCL": 250, "tCH": 250, "tCC": 1000, "tCCH": 60, "tCWH": 1000},
+}
+HC595_TIMING = {
+    2: {"tsu": 50, "th": 3, "tW": 75, "tsuST": 75},
+    5: {"tsu": 10, "th": 3, "tW": 15, "tsuST": 15},
+}
+
+SIGNALS = ["TIME_CE", "TIME_CLOCK", "TIME_DATA",
+           "DIGIT_DATA", "DIGIT_CLOCK", "DIGIT_LATCH", "DIGIT_CLEAR", "DIGIT_OUTPUT", "BENCH"]
+
+#Bench.h ids
+BENCH_NAMES = {1: "update_time", 2: "update_menu", 3: "render", 4: "brightness",
+               5: "timer 1 isr", 6: "timer 0 isr", 7: "read time", 8: "read register",
+               9: "boot to frame", 10: "hang to reset"}
+BENCH_END_FLAG = 0x80
+
+#DS1302 registers, see DS1302.h
+CLOCK_REGISTERS = ["seconds", "minutes", "hour", "date", "month", "day", "year",
+                   "control", "trickle charger"]
+
+TIMESCALE = {"s": 10**9, "ms": 10**6, "us": 10**3, "ns": 1, "ps": 10**-3, "fs": 10**-6}
+
+def read_vcd(path):
+    #Returns the ordered (time ns, signal, value) changes of the known signals
+    ids = {}
+    scale = 1
+    changes = []
+    time = 0
+    with open(path) as vcd:
+        tokens = vcd.read().split()
+    i = 0
+    while i < len(tokens):
+        token = tokens[i]
+        if token == "$timescale":
+            unit = ""
+            i += 1
+            while tokens[i] != "$end":
+                unit += tokens[i]
+                i += 1
+            number = unit.rstrip("munpfs") or "1"
+            scale = int(number) * TIMESCALE[unit[len(number):]]
+        elif token == "$var":
+            #$var wire 1 <id> <name> $end, names may carry a scope prefix
+            name = tokens[i + 4].split(".")[-1]
+            for signal in SIGNALS:
+                if name.endswith(signal):
+                    ids[tokens[i + 3]] = signal
+            while tokens[i] != "$end":
+                i += 1
+        elif token in ("$dumpvars", "$dumpall", "$dumpon", "$dumpoff", "$end"):
+            pass
+        elif token.startswith("$"):
+            while tokens[i] != "$end":
+                i += 1
+        elif token.startswith("#"):
+            time = int(int(token[1:]) * scale)
+        elif token[0] in "bB":
+            if tokens[i + 1] in ids:
+                bits = token[1:]
+                changes.append((time, ids[tokens[i + 1]], int(bits, 2) if bits.strip("01") == "" else 0))
+            i += 1
+        elif token[0] in "rR":
+            i += 1
+        elif token[1:] in ids:
+            changes.append((time, ids[token[1:]], 1 if token[0] == "1" else 0))
+        i += 1
+    return changes
+
+class Report:
+    def __init__(self, listing, quiet=False):
+        self.listing = listing
+        self.quiet = quiet
+        self.violations = collections.Counter()
+        self.busy = collections.defaultdict(lambda: collections.Counter())
+        self.count = collections.defaultdict(lambda: collections.Counter())
+
+    def violation(self, time, bus, rule, measured, minimum):
+        self.violations[bus + " " + rule] += 1
+        if not self.quiet:
+            print("%12.6f %s %s %d ns < %d ns" % (time / 1e9, bus, rule, measured, minimum))
+
+    def error(self, time, bus, message):
+        self.violations[bus + " " + message] += 1
+        if not self.quiet:
+            print("%12.6f %s %s" % (time / 1e9, bus, message))
+
+    def transfer(self, bus, start, end, text):
+        second = start // 10**9
+        self.busy[bus][second] += end - start
+        self.count[bus][second] += 1
+        if self.listing:
+            print("%12.6f %s %s, %.1f us" % (start / 1e9, bus, text, (end - start) / 1e3))
+
+class DS1302Decoder:
+    def __init__(self, report, timing):
+        self.report = report
+        self.timing = timing
+        self.ce = 0
+        self.clock = 0
+        self.data = 0
+        self.ce_fall = None
+        self.transaction = None
+
+    def check(self, time, rule, since):
+        if since is not None and time - since < self.timing[rule]:
+            self.report.violation(time, "DS1302", rule, time - since, self.timing[rule])
+
+    def change(self, time, signal, value):
+        t = self.transaction
+        if signal == "TIME_CE" and value != self.ce:
+            self.ce = value
+            if value:
+                self.check(time, "tCWH", self.ce_fall)
+                if self.clock:
+                    self.report.error(time, "DS1302", "SCLK high when CE rose")
+                self.transaction = {"start": time, "rises": 0, "falls": 0, "bits": [],
+                                    "rise": None, "fall": None, "edge": None, "data": None}
+            elif t is not None:
+                self.check(time, "tCCH", t["edge"])
+                self.finish(t, time)
+                self.transaction = None
+                self.ce_fall = time
+        elif signal == "TIME_CLOCK" and value != self.clock:
+            self.clock = value
+            if t is None:
+                return
+            if value:
+                if t["rises"] == 0:
+                    self.check(time, "tCC", t["start"])
+                self.check(time, "tCL", t["fall"])
+                if self.writing(t):
+                    self.check(time, "tDC", t["data"])
+                    t["bits"].append(self.data)
+                t["rises"] += 1
+                t["rise"] = time
+            else:
+                self.check(time, "tCH", t["rise"])
+                t["falls"] += 1
+                t["fall"] = time
+            t["edge"] = time
+        elif signal == "TIME_DATA":
+            self.data = value
+            #Only edges the MCU drives, reads are driven by the DS1302
+            if t is not None and self.writing(t):
+                self.check(time, "tCDH", t["rise"])
+                t["data"] = time
+
+    def writing(self, t):
+        #Command byte is always written, data only if bit 0 asked for a write
+        return t["rises"] < 8 or not t["bits"][0]
+
+    def finish(self, t, time):
+        if t["rises"] < 8:
+            self.report.error(t["start"], "DS1302", "CE dropped after %d command bits" % t["rises"])
+            return
+        command = sum(bit << i for i, bit in enumerate(t["bits"][:8]))
+        if not command & 0x80:
+            self.report.error(t["start"], "DS1302", "command 0x%02X has bit 7 clear" % command)
+        read = command & 0x01
+        ram = command & 0x40
+        address = (command >> 1) & 0x1F
+        if read:
+            #The DS1302 drives a bit on each falling edge from the 8th
+            count = max(0, t["falls"] - 7) // 8
+            data = ""
+        else:
+            bits = t["bits"][8:]
+            if len(bits) % 8:
+                self.report.error(t["start"], "DS1302", "write ended %d bits into a byte" % (len(bits) % 8))
+            count = len(bits) // 8
+            data = " " + " ".join("%02X" % sum(bit << i for i, bit in enumerate(bits[n * 8:n * 8 + 8]))
+                                  for n in range(count))
+        if address == 0x1F:
+            target = "ram burst" if ram else "clock burst"
+        elif ram:
+            target = "ram %d" % address
+        else:
+            target = CLOCK_REGISTERS[address] if address < len(CLOCK_REGISTERS) else "register %d" % address
+        self.report.transfer("DS1302", t["start"], time, "0x%02X %s %s, %d bytes%s" % (
+            command, "read" if read else "write", target, count, data))
+
+class HC595Decoder:
+    def __init__(self, report, timing, digits, lsb_first, chain_reversed):
+        self.report = report
+        self.timing = timing
+        self.digits = digits
+        self.lsb_first = lsb_first
+        self.chain_reversed = chain_reversed
+        self.levels = {"DIGIT_DATA": 0, "DIGIT_CLOCK": 0, "DIGIT_LATCH": 0, "DIGIT_CLEAR": 1}
+        self.edges = {}
+        self.bits = []
+        self.frame = ""
+        self.start = None
+        self.last_rise = None
+
+    def check(self, time, rule, since):
+        if since is not None and time - since < self.timing[rule]:
+            self.report.violation(time, "595", rule, time - since, self.timing[rule])
+
+    def change(self, time, signal, value):
+        if signal not in self.levels or self.levels[signal] == value:
+            return
+        self.levels[signal] = value
+        since = self.edges.get(signal)
+        self.edges[signal] = time
+        if signal == "DIGIT_DATA":
+            self.check(time, "th", self.last_rise)
+        elif signal == "DIGIT_CLOCK":
+            self.check(time, "tW", since)
+            if value:
+                self.check(time, "tsu", self.edges.get("DIGIT_DATA"))
+                if self.start is None:
+                    self.start = time
+                if self.levels["DIGIT_CLEAR"]:
+                    self.bits.append(self.levels["DIGIT_DATA"])
+                self.last_rise = time
+        elif signal == "DIGIT_LATCH":
+            if value:
+                self.check(time, "tsuST", self.last_rise)
+                self.latch(time)
+            else:
+                self.check(time, "tW", since)
+                if self.start is not None:
+                    self.report.transfer("595", self.start, time, self.frame)
+                self.start = None
+        elif signal == "DIGIT_CLEAR":
+            if value:
+                self.check(time, "tW", since)
+            else:
+                self.bits = []
+
+    def latch(self, time):
+        if len(self.bits) != self.digits * 8:
+            self.report.error(time, "595", "%d bits shifted for %d digits" % (len(self.bits), self.digits))
+        #Last bits shifted sit in the first register of the chain
+        bits = ([0] * self.digits * 8 + self.bits)[-self.digits * 8:]
+        shifted = []
+        for n in range(self.digits):
+            byte = bits[n * 8:n * 8 + 8]
+            if not self.lsb_first:
+                byte.reverse()
+            shifted.append(sum(bit << i for i, bit in enumerate(byte)))
+        if self.chain_reversed:
+            shifted.reverse()
+        self.frame = "frame " + " ".join("%02X" % b for b in shifted)
+        self.bits = []
+
+class BenchDecoder:
+    def __init__(self, f_cpu):
+        self.f_cpu = f_cpu
+        self.stack = []
+        self.cycles = collections.defaultdict(list)
+
+    def change(self, time, signal, value):
+        if signal != "BENCH":
+            return
+        if not value & BENCH_END_FLAG:
+            self.stack.append((value, time))
+            return
+        #Interrupts nest inside the main loop markers, so times are inclusive
+        marker = value & ~BENCH_END_FLAG
+        while self.stack:
+            begin, start = self.stack.pop()
+            if begin == marker:
+                self.cycles[marker].append(round((time - start) * self.f_cpu / 1e9))
+                break
+
+def decode(path, args, quiet=False):
+    report = Report(args.list, quiet)
+    bench = BenchDecoder(args.f_cpu)
+    decoders = [DS1302Decoder(report, DS1302_TIMING[args.vcc]),
+                HC595Decoder(report, HC595_TIMING[args.vcc], args.digits,
+                             not args.msb_first, not args.chain_in_order),
+                bench]
+
+    changes = read_vcd(path)
+    if not changes:
+        sys.exit("no bus signals in " + path)
+    for time, signal, value in changes:
+        for decoder in decoders:
+            decoder.change(time, signal, value)
+    return report, bench, changes[-1][0]
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("vcd", nargs="+")
+    parser.add_argument("--vcc", type=int, choices=[2, 5], default=5)
+    parser.add_argument("--list", action="store_true", help="print every transfer")
+    parser.add_argument("--f-cpu", type=int, default=8000000)
+    #Match Display.h
+    parser.add_argument("--digits", type=int, default=4)
+    parser.add_argument("--msb-first", action="store_true")
+    parser.add_argument("--chain-in-order", action="store_true")
+    args = parser.parse_args()
+
+    if len(args.vcd) > 1:
+        compare(args)
+        return
+
+    report, bench, end = decode(args.vcd[0], args)
+
+    print("second   DS1302 transfers    busy     595 frames    busy")
+    for second in range(end // 10**9 + 1):
+        print("%6d %10d %10.3f%% %10d %10.3f%%" % (second,
+              report.count["DS1302"][second], report.busy["DS1302"][second] / 1e7,
+              report.count["595"][second], report.busy["595"][second] / 1e7))
+
+    if bench.cycles:
+        print("%-14s %8s %8s %8s %8s" % ("cycles", "calls", "min", "avg", "max"))
+        for marker, cycles in sorted(bench.cycles.items()):
+            print("%-14s %8d %8d %8d %8d" % (BENCH_NAMES.get(marker, marker), len(cycles),
+                  min(cycles), sum(cycles) // len(cycles), max(cycles)))
+
+    for rule, count in sorted(report.violations.items()):
+        print("%s: %d" % (rule, count))
+    if report.violations:
+        sys.exit(1)
+
+def compare(args):
+    #One column per trace, average/max cycles per marker
+    results = [decode(path, args, quiet=True) for path in args.vcd]
+    #Builds all write the same file name, the directory tells them apart
+    labels = [os.path.basename(path) for path in args.vcd]
+    if len(set(labels)) < len(labels):
+        labels = [os.path.basename(os.path.dirname(os.path.abspath(path))) for path in args.vcd]
+    print("%-14s" % "cycles" + "".join(" %17s" % label[-17:] for label in labels))
+    for marker in sorted(set(m for _, bench, _ in results for m in bench.cycles)):
+        row = "%-14s" % BENCH_NAMES.get(marker, marker)
+        for _, bench, _ in results:
+            cycles = bench.cycles.get(marker)
+            row += " %17s" % ("%d/%d" % (sum(cycles) // len(cycles), max(cycles)) if cycles else "-")
+        print(row)
+    print("%-14s" % "violations" + "".join(" %17d" % sum(report.violations.values())
+                                           for report, _, _ in results))
+    if any(report.violations for report, _, _ in results):
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
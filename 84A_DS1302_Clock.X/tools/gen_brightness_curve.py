@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+#
+# Generates BrightnessCurve.h, the ambient light to PWM duty table
+#
+# Index is the filtered 8 bit light sensor reading (ADCH), higher = darker
+# Value is the dithered output enable PWM duty, 8 bit OCR0A value plus
+# DITHER_BITS of fraction, higher = display off for longer
+#
+# Usage: python3 tools/gen_brightness_curve.py > BrightnessCurve.h
+
+import sys
+
+GAMMA = 2.2
+MIN_BRIGHTNESS = 60
+DITHER_BITS = 2
+
+#Highest duty the dither can reach without overflowing OCR0A
+MAX_DUTY = 255 << DITHER_BITS
+
+def duty(adc):
+    light = (255 - adc) / 255.0
+    on = light ** GAMMA
+    return max(MIN_BRIGHTNESS << DITHER_BITS, min(MAX_DUTY, int(round(MAX_DUTY - MAX_DUTY * on))))
+
+def main():
+    values = [duty(i) for i in range(256)]
+    out = sys.stdout
+    out.write("/*\n")
+    out.write(" * File:   BrightnessCurve.h\n")
+    out.write(" *\n")
+    out.write(" * Generated by tools/gen_brightness_curve.py - do not edit!\n")
+    out.write(" * Gamma %.1f, minimum duty %d, %d dither bits\n" % (GAMMA, MIN_BRIGHTNESS, DITHER_BITS))
+    out.write(" */\n\n")
+    out.write("#ifndef BRIGHTNESSCURVE_H\n#define\tBRIGHTNESSCURVE_H\n\n")
+    out.write("#include <avr/pgmspace.h>\n\n")
+    out.write("#define BRIGHTNESS_DITHER_BITS %d\n\n" % DITHER_BITS)
+    out.write("const uint16_t brightness_curve[256] PROGMEM =\n{\n")
+    for row in range(0, 256, 16):
+        line = ", ".join("%4d" % v for v in values[row:row + 16])
+        out.write("    " + line + ("," if row < 240 else "") + "\n")
+    out.write("};\n\n#endif\t/* BRIGHTNESSCURVE_H */\n")
+
+if __name__ == "__main__":
+    main()
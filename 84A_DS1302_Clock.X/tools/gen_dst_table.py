@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+#
+# Generates DstTable.h, daylight saving transition dates up to 2099
+#
+# Each year is one byte, high nibble = start date - DST_START_BASE,
+# low nibble = end date - DST_END_BASE
+# The table starts at the year the rule came into force, or 2000, and
+# earlier years get no daylight saving
+#
+# Transitions must stay inside the day, Dst.c moves the hour without
+# touching the date
+#
+# Usage: python3 tools/gen_dst_table.py [--rule eu|us] [--utc-offset N]
+#                                       [--verify Europe/London] > DstTable.h
+
+import argparse
+import calendar
+import datetime
+import sys
+
+#month, which Sunday (-1 = last), UTC hour or local standard hour,
+#first year the rule is in force
+RULES = {
+    "eu": {"start": (3, -1), "end": (10, -1), "utc_hour": 1, "since": 2000},
+    "us": {"start": (3, 2), "end": (11, 1), "local_hour": 2, "since": 2007},
+}
+
+def sunday(year, month, which):
+    days = calendar.monthrange(year, month)[1]
+    sundays = [d for d in range(1, days + 1) if calendar.weekday(year, month, d) == 6]
+    return sundays[which] if which < 0 else sundays[which - 1]
+
+def local_hours(rule, offset):
+    #Local standard hour of the spring jump, local DST hour of the autumn jump
+    if "utc_hour" in rule:
+        start = rule["utc_hour"] + offset
+        return start, start + 1
+    return rule["local_hour"], rule["local_hour"]
+
+def verify(rule, offset, zone, years):
+    from zoneinfo import ZoneInfo
+    tz = ZoneInfo(zone)
+    utc = datetime.timezone.utc
+    start_hour, end_hour = local_hours(rule, offset)
+    for year in years:
+        for (month, which), hour in ((rule["start"], start_hour), (rule["end"], end_hour)):
+            date = sunday(year, month, which)
+            #Transition instant in UTC, wall clock reads hour:00 just before it
+            std = datetime.timedelta(hours=offset)
+            dst = std + datetime.timedelta(hours=1)
+            shift = std if month == rule["start"][0] else dst
+            instant = datetime.datetime(year, month, date, hour, tzinfo=utc) - shift
+            before = (instant - datetime.timedelta(minutes=1)).astimezone(tz).utcoffset()
+            after = instant.astimezone(tz).utcoffset()
+            if before == after:
+                sys.exit("%s: no transition at %s" % (zone, instant))
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--rule", default="eu", choices=sorted(RULES))
+    parser.add_argument("--utc-offset", type=int, default=0)
+    parser.add_argument("--verify", metavar="ZONE")
+    args = parser.parse_args()
+
+    rule = RULES[args.rule]
+    first = max(rule["since"], 2000)
+    years = range(first, 2100)
+    start_hour, end_hour = local_hours(rule, args.utc_offset)
+
+    #Forward from start_hour to start_hour + 1, back from end_hour to end_hour - 1
+    if not 0 <= start_hour <= 22 or not 1 <= end_hour <= 23:
+        sys.exit("transitions at %d:00 and %d:00 local would cross midnight" % (start_hour, end_hour))
+
+    starts = [sunday(y, *rule["start"]) for y in years]
+    ends = [sunday(y, *rule["end"]) for y in years]
+    start_base = min(starts)
+    end_base = min(ends)
+    assert max(starts) - start_base < 16 and max(ends) - end_base < 16
+
+    if args.verify:
+        verify(rule, args.utc_offset, args.verify, years)
+
+    out = sys.stdout
+    out.write("/*\n")
+    out.write(" * File:   DstTable.h\n")
+    out.write(" *\n")
+    out.write(" * Generated by tools/gen_dst_table.py - do not edit!\n")
+    out.write(" * Rule %s, UTC offset %+d\n" % (args.rule.upper(), args.utc_offset))
+    out.write(" */\n\n")
+    out.write("#ifndef DSTTABLE_H\n#define\tDSTTABLE_H\n\n")
+    out.write("#include <avr/pgmspace.h>\n\n")
+    out.write("//Year 0 - 99 of the first table entry, earlier years have no daylight saving\n")
+    out.write("#define DST_FIRST_YEAR %d\n\n" % (first - 2000))
+    out.write("//Local standard time hour clocks go forward\n")
+    out.write("#define DST_START_MONTH %d\n" % rule["start"][0])
+    out.write("#define DST_START_HOUR %d\n" % start_hour)
+    out.write("#define DST_START_BASE %d\n\n" % start_base)
+    out.write("//Local daylight time hour clocks go back\n")
+    out.write("#define DST_END_MONTH %d\n" % rule["end"][0])
+    out.write("#define DST_END_HOUR %d\n" % end_hour)
+    out.write("#define DST_END_BASE %d\n\n" % end_base)
+    out.write("const uint8_t dstDates[100 - DST_FIRST_YEAR] PROGMEM =\n{\n")
+    packed = ["0x%X%X" % (s - start_base, e - end_base) for s, e in zip(starts, ends)]
+    rows = range(0, len(packed), 10)
+    for row in rows:
+        out.write("    " + ", ".join(packed[row:row + 10]) + ("," if row < rows[-1] else "") + "\n")
+    out.write("};\n\n#endif\t/* DSTTABLE_H */\n")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+#
+# Host side of the serial configuration protocol (see Protocol.h)
+#
+# Usage: python3 tools/provision.py PORT read-clock
+#        python3 tools/provision.py PORT set-time [YYYY-MM-DDTHH:MM:SS]
+#        python3 tools/provision.py PORT read-ram FIRST COUNT
+#        python3 tools/provision.py PORT write-ram FIRST BYTE...
+#        python3 tools/provision.py PORT read-alarm INDEX
+#        python3 tools/provision.py PORT write-alarm INDEX DAYMASK HH:MM
+#        python3 tools/provision.py PORT read-log
+#
+# Needs pyserial
+
+import argparse
+import datetime
+import sys
+
+import serial
+
+SYNC_REQUEST = 0xA5
+SYNC_RESPONSE = 0x5A
+
+CLOCK_READ = 0x01
+CLOCK_WRITE = 0x02
+RAM_READ = 0x05
+RAM_WRITE = 0x06
+ALARM_READ = 0x07
+ALARM_WRITE = 0x08
+
+#Event log layout, see EventLog.h
+LOG_HEAD = 7
+LOG_RECORDS = 11
+EVENTS = ["boot", "power lost", "time edited", "sync skipped"]
+DAYS = ["Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"]
+
+STATUS = {0: "ok", 1: "crc error", 2: "bad command", 3: "bad argument"}
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+def bcd(value):
+    return ((value // 10) << 4) | (value % 10)
+
+def from_bcd(value):
+    return (value >> 4) * 10 + (value & 0x0F)
+
+def transact(port, command, argument=0, data=b""):
+    body = bytes([command, argument, len(data)]) + bytes(data)
+    port.write(bytes([SYNC_REQUEST]) + body + bytes([crc8(body)]))
+    header = port.read(3)
+    if len(header) != 3 or header[0] != SYNC_RESPONSE:
+        sys.exit("no response")
+    payload = port.read(header[2] + 1)
+    if crc8(header[1:] + payload) != 0:
+        sys.exit("response crc error")
+    if header[1] != 0:
+        sys.exit(STATUS.get(header[1], "error %d" % header[1]))
+    return payload[:-1]
+
+def clock_image(when):
+    #24 hour mode, clock running, write protect off, DS1302 day 1 = Monday
+    return bytes([bcd(when.second), bcd(when.minute), bcd(when.hour), bcd(when.day),
+                  bcd(when.month), when.isoweekday(), bcd(when.year - 2000), 0x00])
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("port")
+    parser.add_argument("command")
+    parser.add_argument("args", nargs="*")
+    parser.add_argument("--baud", type=int, default=9600)
+    args = parser.parse_args()
+
+    port = serial.Serial(args.port, args.baud, timeout=1)
+
+    if args.command == "read-clock":
+        image = transact(port, CLOCK_READ)
+        print(" ".join("%02X" % b for b in image))
+        hour = image[2] & 0x3F if not image[2] & 0x80 else image[2] & 0x1F
+        print("20%02d-%02d-%02d %02d:%02d:%02d" % (from_bcd(image[6]), from_bcd(image[4]),
+              from_bcd(image[3]), from_bcd(hour), from_bcd(image[1]), from_bcd(image[0] & 0x7F)))
+    elif args.command == "set-time":
+        when = datetime.datetime.fromisoformat(args.args[0]) if args.args else datetime.datetime.now()
+        transact(port, CLOCK_WRITE, 0, clock_image(when))
+    elif args.command == "read-ram":
+        data = transact(port, RAM_READ, int(args.args[0]), bytes([int(args.args[1])]))
+        print(" ".join("%02X" % b for b in data))
+    elif args.command == "write-ram":
+        transact(port, RAM_WRITE, int(args.args[0]), bytes(int(b, 0) for b in args.args[1:]))
+    elif args.command == "read-alarm":
+        days, hour, minute = transact(port, ALARM_READ, int(args.args[0]))
+        print("days 0x%02X %02d:%02d" % (days, hour, minute))
+    elif args.command == "write-alarm":
+        hour, minute = (int(v) for v in args.args[2].split(":"))
+        transact(port, ALARM_WRITE, int(args.args[0]), bytes([int(args.args[1], 0), hour, minute]))
+    elif args.command == "read-log":
+        data = transact(port, RAM_READ, LOG_HEAD, bytes([1 + LOG_RECORDS * 2]))
+        head = data[0] if data[0] < LOG_RECORDS else 0
+        #Oldest first, the head points at the oldest record once the log has wrapped
+        for i in list(range(head, LOG_RECORDS)) + list(range(head)):
+            record = (data[1 + i * 2] << 8) | data[2 + i * 2]
+            minute = record & 0x3FFF
+            if minute >= 7 * 1440:
+                continue
+            print("%s %02d:%02d %s" % (DAYS[minute // 1440], minute % 1440 // 60, minute % 60,
+                  EVENTS[record >> 14]))
+    else:
+        sys.exit("unknown command " + args.command)
+
+if __name__ == "__main__":
+    main()
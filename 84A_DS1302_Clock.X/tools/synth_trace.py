@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# Writes a VCD with known bus traffic so tools/decode_trace.py can be
+# checked without simavr
+#
+# A seconds read, a seconds write of 25, an 8 byte clock burst read,
+# one latched 595 frame of 0 1 2 3 and a read time bench span
+# With --short-sclk every command bit has SCLK high for 100ns, which
+# breaks tCH at either supply
+#
+# Usage: python3 tools/synth_trace.py > good.vcd
+#        python3 tools/synth_trace.py --short-sclk > bad.vcd
+#
+# decode_trace.py should list the three DS1302 transfers and the frame,
+# and exit 0 for the first and 1 for the second
+
+import argparse
+
+#Identifier per signal, names as SimTrace.c records them
+SIGNALS = {"TIME_CE": "!", "TIME_CLOCK": "\"", "TIME_DATA": "#",
+           "DIGIT_DATA": "$", "DIGIT_CLOCK": "%", "DIGIT_LATCH": "&",
+           "DIGIT_CLEAR": "'", "BENCH": "("}
+
+#Bench.h ids
+BENCH_READ_TIME = 7
+BENCH_END_FLAG = 0x80
+
+#Segment patterns for 0 1 2 3, see segmentNumbers in main.c
+FRAME = [0xFC, 0x60, 0xDA, 0xF2]
+
+class Trace:
+    def __init__(self, sclk_high):
+        self.time = 1000
+        self.sclk_high = sclk_high
+        self.changes = []
+
+    def put(self, signal, value, wait=0):
+        self.changes.append((self.time, signal, value))
+        self.time += wait
+
+    #Slow enough for the DS1302 at 2V apart from SCLK high on command bits
+    def ds1302(self, command, data=(), read_bytes=0):
+        self.put("TIME_CE", 1, 4000)
+        for n, byte in enumerate([command] + list(data)):
+            for i in range(8):
+                self.put("TIME_DATA", (byte >> i) & 1, 1000)
+                self.put("TIME_CLOCK", 1, self.sclk_high if n == 0 else 1000)
+                self.put("TIME_CLOCK", 0, 1000)
+        for _ in range(read_bytes * 8):
+            self.put("TIME_CLOCK", 1, 1000)
+            self.put("TIME_CLOCK", 0, 1000)
+        self.time += 1000
+        self.put("TIME_CE", 0, 5000)
+
+    #LSB first, last byte shifted lands in the first register
+    def frame(self, digits):
+        for digit in reversed(digits):
+            for i in range(8):
+                self.put("DIGIT_DATA", (digit >> i) & 1, 100)
+                self.put("DIGIT_CLOCK", 1, 100)
+                self.put("DIGIT_CLOCK", 0, 100)
+        self.put("DIGIT_LATCH", 1, 100)
+        self.put("DIGIT_LATCH", 0, 1000)
+
+    def write(self):
+        print("$timescale 1ns $end")
+        print("$scope module logic $end")
+        for name, code in SIGNALS.items():
+            print("$var wire %d %s %s $end" % (8 if name == "BENCH" else 1, code, name))
+        print("$upscope $end")
+        print("$enddefinitions $end")
+        print("#0")
+        print("$dumpvars")
+        for name, code in SIGNALS.items():
+            print(("b0 " + code) if name == "BENCH" else ("0" + code))
+        print("$end")
+        last = None
+        for time, signal, value in self.changes:
+            if time != last:
+                print("#%d" % time)
+                last = time
+            if signal == "BENCH":
+                print("b{:b} {}".format(value, SIGNALS[signal]))
+            else:
+                print("%d%s" % (value, SIGNALS[signal]))
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--short-sclk", action="store_true")
+    args = parser.parse_args()
+
+    trace = Trace(100 if args.short_sclk else 1000)
+    trace.put("DIGIT_CLEAR", 1)
+    trace.put("BENCH", BENCH_READ_TIME, 100)
+    trace.ds1302(0x81, read_bytes=1)
+    trace.put("BENCH", BENCH_READ_TIME | BENCH_END_FLAG, 100)
+    trace.ds1302(0x80, [0x25])
+    trace.ds1302(0xBF, read_bytes=8)
+    trace.frame(FRAME)
+    trace.write()
+
+if __name__ == "__main__":
+    main()